@@ -0,0 +1,584 @@
+#include "rtos.h"
+#include "port.h"
+#include "uart.h"
+
+#ifdef RTOS_PORT_POSIX
+#include <stdlib.h>
+#else
+#define SCB_VTOR   (*(volatile uint32_t *)0xE000ED08)
+#endif
+
+// ----------------------------------------------
+// Micro-benchmark-uri kernel (firmware separat: build/bench.elf)
+// ----------------------------------------------
+// Fiecare benchmark = BENCH_ROUNDS runde a cate `iters` operatii; se masoara
+// cu port_cycles() (DWT_CYCCNT pe Cortex-M3, TSC pe host) costul mediu pe
+// operatie al fiecarei runde. Iesire pe UART, cate o linie per rezultat:
+//
+//   BENCH name=sem_pingpong iters=256 avg=812 min=790 max=901
+//
+// avg = media pe toate rundele, min/max = cea mai buna / cea mai proasta runda,
+// toate in cicluri per operatie. Parametrii extra (depth=, tasks=, timers=)
+// apar inainte de iters=.
+
+#define BENCH_ROUNDS      8
+#define BENCH_ITERS       256
+#define BENCH_MSGS        512
+#define BENCH_SLEEPERS    (RTOS_MAX_TASKS - 5)   // idle, bench, partner, consumer + 1 rezerva
+#define BENCH_TIMERS      32
+#define BENCH_PRIO_MAIN   10
+#define BENCH_PRIO_PARTNER 11
+#define BENCH_PRIO_SLEEPER 12
+
+typedef struct {
+    uint64_t sum;
+    uint32_t rounds;
+    uint32_t min;
+    uint32_t max;
+} bench_acc_t;
+
+typedef enum {
+    CMD_PINGPONG = 0,
+    CMD_MUTEX,
+    CMD_NOTIFY,
+} partner_cmd_t;
+
+typedef enum {
+    CONS_QUEUE = 0,
+    CONS_SPSC,
+    CONS_YIELD,
+} consumer_cmd_t;
+
+static rtos_sem_t partner_go;
+static rtos_sem_t sem_ping;
+static rtos_sem_t sem_pong;
+static volatile partner_cmd_t partner_cmd;
+static volatile uint32_t partner_iters;
+static rtos_tcb_t *partner_tcb;
+static rtos_tcb_t *bench_tcb;
+
+static rtos_mutex_t bench_mutex;
+static rtos_mutex_t bench_mutex_ipcp;        // plafon = BENCH_PRIO_PARTNER
+
+static rtos_sem_t cons_go;
+static rtos_sem_t cons_done;
+static volatile consumer_cmd_t cons_cmd;
+static volatile uint32_t cons_msgs;
+static rtos_queue_t bench_queue;
+static rtos_spsc_queue_t bench_spsc;
+static uint32_t spsc_buf[64];
+
+static rtos_sem_t sleeper_go;
+static rtos_timer_t bench_timers[BENCH_TIMERS];
+
+static uint32_t bench_lines = 0;
+
+// ----------------------------------------------
+// Acumulare si afisare
+// ----------------------------------------------
+static void acc_reset(bench_acc_t *a)
+{
+    a->sum = 0;
+    a->rounds = 0;
+    a->min = 0xFFFFFFFFu;
+    a->max = 0;
+}
+
+static void acc_add(bench_acc_t *a, uint32_t cycles, uint32_t iters)
+{
+    uint32_t per_op = cycles / iters;
+    a->sum += per_op;
+    a->rounds++;
+    if (per_op < a->min) a->min = per_op;
+    if (per_op > a->max) a->max = per_op;
+}
+
+static void bench_name(const char *name)
+{
+    uart_puts("BENCH name=");
+    uart_puts(name);
+}
+
+static void bench_param(const char *key, uint32_t val)
+{
+    uart_puts(" ");
+    uart_puts(key);
+    uart_puts("=");
+    uart_print_uint(val);
+}
+
+static void bench_result(const bench_acc_t *a, uint32_t iters)
+{
+    bench_param("iters", iters);
+    bench_param("avg", a->rounds ? (uint32_t)(a->sum / a->rounds) : 0);
+    bench_param("min", a->min);
+    bench_param("max", a->max);
+    uart_puts("\n");
+    bench_lines++;
+
+    // lasam UART-ul sa goleasca buffer-ul TX inainte de urmatoarea masuratoare
+    rtos_delay(20);
+}
+
+// ----------------------------------------------
+// Task-uri ajutatoare
+// ----------------------------------------------
+// prioritate mai mare decat bench: ruleaza imediat ce e semnalat
+void bench_partner(void)
+{
+    while (1) {
+        rtos_sem_wait(&partner_go);
+        uint32_t n = partner_iters;
+
+        switch (partner_cmd) {
+        case CMD_PINGPONG:
+            for (uint32_t i = 0; i < n; i++) {
+                rtos_sem_wait(&sem_ping);
+                rtos_sem_signal(&sem_pong);
+            }
+            break;
+        case CMD_MUTEX:
+            for (uint32_t i = 0; i < n; i++) {
+                rtos_sem_wait(&sem_ping);
+                rtos_mutex_lock(&bench_mutex);      // blocheaza: bench tine mutex-ul
+                rtos_mutex_unlock(&bench_mutex);
+            }
+            break;
+        case CMD_NOTIFY:
+            for (uint32_t i = 0; i < n; i++) {
+                (void)rtos_notify_take(1, 0xFFFFFFFFu);
+                rtos_notify_give(bench_tcb);
+            }
+            break;
+        }
+    }
+}
+
+// aceeasi prioritate ca bench: ruleaza doar cand producatorul se blocheaza,
+// deci numarul de comutari pe mesaj depinde de adancimea cozii
+void bench_consumer(void)
+{
+    while (1) {
+        rtos_sem_wait(&cons_go);
+        uint32_t n = cons_msgs;
+        uint32_t msg;
+
+        for (uint32_t i = 0; i < n; i++) {
+            if (cons_cmd == CONS_QUEUE) {
+                msg = rtos_queue_receive(&bench_queue);
+            } else if (cons_cmd == CONS_SPSC) {
+                (void)rtos_spsc_receive(&bench_spsc, &msg, 0xFFFFFFFFu);
+            } else {
+                rtos_yield();
+            }
+        }
+        (void)msg;
+        rtos_sem_signal(&cons_done);
+    }
+}
+
+// intra in delay_list cu un wake_tick foarte indepartat
+void bench_sleeper(void)
+{
+    rtos_sem_wait(&sleeper_go);
+    while (1) rtos_delay(0x40000000u);
+}
+
+void bench_idle(void)
+{
+    while (1) rtos_idle_sleep();
+}
+
+static void bench_timer_cb(void)
+{
+}
+
+// ----------------------------------------------
+// Benchmark-uri
+// ----------------------------------------------
+// rtos_yield() fara alt task READY la aceeasi prioritate: PendSV + scheduler + revenire
+static void bench_yield(void)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) rtos_yield();
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+
+    bench_name("yield");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// doua task-uri de aceeasi prioritate care isi cedeaza reciproc CPU-ul (round-robin)
+static void bench_yield_peer(void)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        cons_cmd = CONS_YIELD;
+        cons_msgs = BENCH_ITERS;
+        rtos_sem_signal(&cons_go);
+
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) rtos_yield();
+        rtos_sem_wait(&cons_done);
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+
+    bench_name("yield_peer");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// signal -> partner trezit (preemptie) -> signal inapoi -> partner blocat -> revenire
+static void bench_sem_pingpong(void)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        partner_cmd = CMD_PINGPONG;
+        partner_iters = BENCH_ITERS;
+        rtos_sem_signal(&partner_go);       // partner-ul ajunge blocat pe sem_ping
+
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_sem_signal(&sem_ping);
+            rtos_sem_wait(&sem_pong);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+
+    bench_name("sem_pingpong");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// acelasi ping-pong ca sem_pingpong, dar prin notificari directe catre task.
+// Nu arata niciun castig: ambele sunt dominate de context switch si pe host ies
+// la acelasi cost, in limita zgomotului
+static void bench_notify_pingpong(void)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        partner_cmd = CMD_NOTIFY;
+        partner_iters = BENCH_ITERS;
+        rtos_sem_signal(&partner_go);       // partner-ul ajunge blocat in notify_take
+
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_notify_give(partner_tcb);
+            (void)rtos_notify_take(1, 0xFFFFFFFFu);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+
+    bench_name("notify_pingpong");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// semnal fara waiter (ex. ISR care anunta un driver deja ocupat) + consumarea lui;
+// singurul loc unde notificarea e mai ieftina (pe host ~20 fata de ~40 de cicluri)
+static void bench_signal_nowait(void)
+{
+    bench_acc_t a;
+    static rtos_sem_t s;
+    rtos_sem_init(&s, 0);
+
+    acc_reset(&a);
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_sem_signal(&s);
+            (void)rtos_sem_wait_timeout(&s, 0);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+    bench_name("sem_signal_nowait");
+    bench_result(&a, BENCH_ITERS);
+
+    acc_reset(&a);
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_notify_give(bench_tcb);
+            (void)rtos_notify_take(1, 0);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+    bench_name("notify_give_nowait");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// doar take pe un semafor cu jetoane (calea rapida port_cas), fara signal
+static void bench_sem_take_uncontended(void)
+{
+    bench_acc_t a;
+    static rtos_sem_t s;
+
+    acc_reset(&a);
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        rtos_sem_init(&s, BENCH_ITERS);
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            (void)rtos_sem_wait_timeout(&s, 0);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+    bench_name("sem_take_uncontended");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// IPCP: sectiune critica in loc de CAS, dar fara mutare in ready list si fara
+// PendSV cat nimeni nu e preemptat pe durata plafonului
+static void bench_mutex_uncontended(rtos_mutex_t *m, const char *name)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_mutex_lock(m);
+            rtos_mutex_unlock(m);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+
+    bench_name(name);
+    bench_result(&a, BENCH_ITERS);
+}
+
+// partner-ul (prioritate mai mare) se blocheaza pe mutex, ridica prioritatea
+// lui bench (PI), apoi il primeste la unlock
+static void bench_mutex_contended(void)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        partner_cmd = CMD_MUTEX;
+        partner_iters = BENCH_ITERS;
+        rtos_sem_signal(&partner_go);
+
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_mutex_lock(&bench_mutex);
+            uint32_t t0 = port_cycles();
+            rtos_sem_signal(&sem_ping);         // partner: lock -> blocat
+            rtos_mutex_unlock(&bench_mutex);    // handoff -> partner: unlock -> blocat pe sem_ping
+            total += port_cycles() - t0;
+        }
+        acc_add(&a, total, BENCH_ITERS);
+    }
+
+    bench_name("mutex_contended");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// producator (bench) si consumator la aceeasi prioritate; cost per mesaj
+static uint32_t run_xfer(consumer_cmd_t cmd)
+{
+    cons_cmd = cmd;
+    cons_msgs = BENCH_MSGS;
+    rtos_sem_signal(&cons_go);
+
+    uint32_t t0 = port_cycles();
+    for (uint32_t i = 0; i < BENCH_MSGS; i++) {
+        if (cmd == CONS_QUEUE) {
+            rtos_queue_send(&bench_queue, i);
+        } else {
+            (void)rtos_spsc_send(&bench_spsc, &i, 0xFFFFFFFFu);
+        }
+    }
+    rtos_sem_wait(&cons_done);
+    return port_cycles() - t0;
+}
+
+static void bench_queue_xfer(void)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        acc_add(&a, run_xfer(CONS_QUEUE), BENCH_MSGS);
+    }
+
+    bench_name("queue_xfer");
+    bench_param("depth", RTOS_QUEUE_LENGTH);
+    bench_result(&a, BENCH_MSGS);
+}
+
+static void bench_spsc_xfer(void)
+{
+    static const uint32_t depths[] = { 1, 4, 16, 64 };
+
+    for (uint32_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+        bench_acc_t a;
+        acc_reset(&a);
+        rtos_spsc_init(&bench_spsc, spsc_buf, sizeof(uint32_t), depths[d]);
+
+        for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+            acc_add(&a, run_xfer(CONS_SPSC), BENCH_MSGS);
+        }
+
+        bench_name("spsc_xfer");
+        bench_param("depth", depths[d]);
+        bench_result(&a, BENCH_MSGS);
+    }
+}
+
+static void bench_timer_start_stop(void)
+{
+    bench_acc_t a;
+    rtos_timer_t t;
+    acc_reset(&a);
+    rtos_timer_init(&t, 1000, bench_timer_cb);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < BENCH_ITERS; i++) {
+            rtos_timer_start(&t);
+            rtos_timer_stop(&t);
+        }
+        acc_add(&a, port_cycles() - t0, BENCH_ITERS);
+    }
+
+    bench_name("timer_start_stop");
+    bench_result(&a, BENCH_ITERS);
+}
+
+// rtos_tick_handler() apelat direct, in sectiune critica, pe o tura completa a
+// rotii de timere (fiecare slot vizitat o data); fara intrarea in exceptie
+static void bench_tick_one(uint32_t tasks, uint32_t timers)
+{
+    bench_acc_t a;
+    acc_reset(&a);
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t irq = port_enter_critical();
+        uint32_t t0 = port_cycles();
+        for (uint32_t i = 0; i < RTOS_TIMER_WHEEL_SIZE; i++) rtos_tick_handler();
+        uint32_t dt = port_cycles() - t0;
+        port_exit_critical(irq);
+        acc_add(&a, dt, RTOS_TIMER_WHEEL_SIZE);
+    }
+
+    bench_name("tick_isr");
+    bench_param("tasks", tasks);
+    bench_param("timers", timers);
+    bench_result(&a, RTOS_TIMER_WHEEL_SIZE);
+}
+
+static void bench_tick(void)
+{
+    static const uint32_t timer_steps[] = { 0, 8, BENCH_TIMERS };
+    uint32_t sleepers = 0;
+    uint32_t armed = 0;
+
+    for (uint32_t s = 0; s < 2; s++) {
+        // a doua trecere: toate task-urile sleeper in delay_list
+        while (s == 1 && sleepers < BENCH_SLEEPERS) {
+            rtos_sem_signal(&sleeper_go);       // sleeper-ul (prioritate mai mare) intra in delay
+            sleepers++;
+        }
+
+        for (uint32_t k = 0; k < sizeof(timer_steps) / sizeof(timer_steps[0]); k++) {
+            // perioade mari si distincte: timerele se imprastie prin sloturi, dar nu expira
+            while (armed < timer_steps[k]) {
+                rtos_timer_init(&bench_timers[armed], 100000u + armed * 3u, bench_timer_cb);
+                rtos_timer_start(&bench_timers[armed]);
+                armed++;
+            }
+            bench_tick_one(sleepers, armed);
+        }
+
+        for (uint32_t i = 0; i < armed; i++) rtos_timer_stop(&bench_timers[i]);
+        armed = 0;
+    }
+}
+
+void bench_task(void)
+{
+    // daca CYCCNT nu numara (ex. emulator fara DWT), rezultatele sunt 0
+    uint32_t c0 = port_cycles();
+    rtos_delay(2);
+
+#ifdef RTOS_PORT_POSIX
+    uart_puts("BENCH_BEGIN port=posix cpu_hz=");   // TSC pe host, nu CPU_CLOCK_HZ
+#else
+    uart_puts("BENCH_BEGIN port=cm3 cpu_hz=");
+#endif
+    uart_print_uint(CPU_CLOCK_HZ);
+    uart_puts(" tick_hz=");
+    uart_print_uint(RTOS_TICK_RATE_HZ);
+    uart_puts(" rounds=");
+    uart_print_uint(BENCH_ROUNDS);
+    if (port_cycles() == c0) uart_puts(" cycle_counter=stopped");
+    uart_puts("\n");
+    rtos_delay(20);
+
+    bench_yield();
+    bench_yield_peer();
+    bench_sem_pingpong();
+    bench_notify_pingpong();
+    bench_signal_nowait();
+    bench_sem_take_uncontended();
+    bench_mutex_uncontended(&bench_mutex, "mutex_uncontended");
+    bench_mutex_uncontended(&bench_mutex_ipcp, "mutex_ipcp_uncontended");
+    bench_mutex_contended();
+    bench_queue_xfer();
+    bench_spsc_xfer();
+    bench_timer_start_stop();
+    bench_tick();
+
+    uart_puts("BENCH_END results=");
+    uart_print_uint(bench_lines);
+    uart_puts("\n");
+
+#ifdef RTOS_PORT_POSIX
+    exit(0);
+#else
+    while (1) rtos_delay(1000);
+#endif
+}
+
+// ----------------------------------------------
+// Main
+// ----------------------------------------------
+int main(void)
+{
+#ifndef RTOS_PORT_POSIX
+    __asm volatile("cpsid i");
+    SCB_VTOR = 0x08000000;
+#endif
+
+    uart_init();
+    rtos_init();
+
+    rtos_sem_init(&partner_go, 0);
+    rtos_sem_init(&sem_ping, 0);
+    rtos_sem_init(&sem_pong, 0);
+    rtos_sem_init(&cons_go, 0);
+    rtos_sem_init(&cons_done, 0);
+    rtos_sem_init(&sleeper_go, 0);
+    rtos_mutex_init(&bench_mutex);
+    rtos_mutex_init_ceiling(&bench_mutex_ipcp, BENCH_PRIO_PARTNER);
+    rtos_queue_init(&bench_queue);
+
+    rtos_task_create(bench_idle, 0);
+    bench_tcb = rtos_task_create(bench_task, BENCH_PRIO_MAIN);
+    rtos_task_create(bench_consumer, BENCH_PRIO_MAIN);
+    partner_tcb = rtos_task_create(bench_partner, BENCH_PRIO_PARTNER);
+    for (uint32_t i = 0; i < BENCH_SLEEPERS; i++) {
+        rtos_task_create(bench_sleeper, BENCH_PRIO_SLEEPER);
+    }
+
+    rtos_start();
+
+    while (1) {}
+}
@@ -0,0 +1,774 @@
+#include "rtos.h"
+#include "port.h"
+#include "uart.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// ----------------------------------------------
+// Simulator de scenarii aleatoare (build-ul de host)
+// ----------------------------------------------
+// Fiecare scenariu ruleaza intr-un proces copil (kernelul are stare statica):
+// un set aleator de task-uri worker cu prioritati aleatoare face operatii
+// aleatoare pe mutex / semafor / cozi / pool+mailbox / event group / notificari /
+// timere (worker-ul 0 e si producatorul cozii SPSC), iar un task supervisor de prioritate maxima verifica invariantii.
+// Un task periodic EDF isi depaseste din cand in cand perioada (overrun) si
+// verifica ca ruleaza doar cand are deadline-ul cel mai apropiat.
+// Cu tickless idle pe host timpul e virtual, asa ca mii de scenarii ruleaza
+// in cateva secunde.
+//
+//   build/host/rtos_sim [-n runs] [-s seed] [-t ticks] [-v]
+
+// idle, supervisor, 2 consumatori coada, 1 mbox, 1 SPSC, 1 periodic EDF (+ daemon-ul de timere)
+#define SIM_MAX_WORKERS  (RTOS_MAX_TASKS - 7 - RTOS_TIMER_TASK)
+#define SIM_CONSUMERS    5                      // task-uri care ajung in park pe langa workeri
+#define SIM_SEM_TOKENS   3
+#define SIM_POOL_BLOCKS  4
+#define SIM_POOL_BLOCK   32u
+#define SIM_TIMERS       3
+#define SIM_SPSC_DEPTH   4
+#define SIM_CHECK_PERIOD 7
+#define SIM_EDF_OVERRUNS 2                      // overrun-uri fortate: fiecare costa ~o perioada de timp real
+#define SIM_DRAIN_TICKS  3000
+#define SIM_CPU_LIMIT_S  20
+
+#define INF 0xFFFFFFFFu
+
+// ---- configuratia scenariului (aleasa in copil inainte de rtos_start)
+static uint32_t sim_seed;
+static uint32_t sim_ticks = 3000;
+static int sim_verbose = 0;
+static uint32_t nworkers;
+static uint32_t worker_prio[SIM_MAX_WORKERS];
+static rtos_tcb_t *worker_tcb[SIM_MAX_WORKERS];
+
+// ---- obiectele testate
+static rtos_mutex_t sim_mutex[2];         // imbricate doar in ordinea 0 -> 1; 1 e uneori IPCP
+static rtos_sem_t sim_sem;
+static rtos_queue_t sim_queue[2];
+static rtos_pool_t sim_pool;
+RTOS_POOL_STORAGE(sim_pool_storage, SIM_POOL_BLOCK, SIM_POOL_BLOCKS);
+static rtos_mbox_t sim_mbox;
+static rtos_timer_t sim_timer[SIM_TIMERS];
+static rtos_event_group_t sim_events;
+// item SPSC mai mare de un cuvant: o copiere rupta se vede in pattern
+typedef struct { uint32_t seq; uint32_t pattern; uint32_t inv; } sim_spsc_item_t;
+static rtos_spsc_queue_t sim_spsc;
+static sim_spsc_item_t sim_spsc_buf[SIM_SPSC_DEPTH];
+
+// ---- starea observata de supervisor
+static volatile uint32_t stop = 0;
+static volatile uint32_t parked = 0;
+static volatile uint32_t workers_parked = 0;
+static volatile uint32_t next_worker_id = 0;
+static volatile uint32_t mutex_holder[2];        // id+1 al detinatorului, 0 = liber
+static volatile uint32_t sem_held = 0;
+static volatile uint32_t q_sent[2];
+static volatile uint32_t q_recv[2];
+static uint32_t q_last_seq[2][SIM_MAX_WORKERS];
+static volatile uint32_t mbox_posted = 0;
+static volatile uint32_t mbox_fetched = 0;
+static volatile uint32_t spsc_sent = 0;
+static volatile uint32_t spsc_recv = 0;
+static volatile uint32_t timer_count[SIM_TIMERS];
+static uint32_t timer_start_tick[SIM_TIMERS];
+static uint32_t timer_stopped[SIM_TIMERS];
+static volatile uint32_t event_wakes = 0;
+static volatile uint32_t notify_given = 0;
+static volatile uint32_t notify_taken = 0;
+static uint32_t edf_forced_overruns = 0;
+static uint32_t ops_done = 0;
+
+static uint32_t xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+// seed-uri consecutive -> stari de pornire bine amestecate (nenule)
+static uint32_t seed_mix(uint32_t x)
+{
+    x = (x ^ (x >> 16)) * 0x7FEB352Du;
+    x = (x ^ (x >> 15)) * 0x846CA68Bu;
+    x ^= x >> 16;
+    return x ? x : 1u;
+}
+
+static uint32_t rnd(uint32_t *s, uint32_t n)
+{
+    return xorshift32(s) % n;
+}
+
+static void sim_fail(const char *what, uint32_t a, uint32_t b)
+{
+    char msg[160];
+    (void)port_enter_critical();
+    int n = snprintf(msg, sizeof(msg), "FAIL seed=%u tick=%u: %s (%u, %u)\n",
+                     sim_seed, rtos_now(), what, a, b);
+    if (n > 0) (void)!write(STDERR_FILENO, msg, (size_t)n);
+    _exit(1);
+}
+
+#define SIM_CHECK(cond, a, b) do { if (!(cond)) sim_fail(#cond, (a), (b)); } while (0)
+
+#if RTOS_DEBUG
+static void sim_assert(const char *file, uint32_t line)
+{
+    (void)file;
+    sim_fail("RTOS_ASSERT", line, 0);
+}
+#endif
+
+static void park(void)
+{
+    uint32_t irq = port_enter_critical();
+    parked++;
+    port_exit_critical(irq);
+    while (1) rtos_delay(1000);
+}
+
+static uint32_t random_timeout(uint32_t *s)
+{
+    switch (rnd(s, 4)) {
+    case 0:  return 0;
+    case 1:  return INF;
+    default: return 1 + rnd(s, 20);
+    }
+}
+
+// ----------------------------------------------
+// Operatii worker
+// ----------------------------------------------
+static int mutex_take(uint32_t mi, uint32_t id, uint32_t *s)
+{
+    if (rtos_mutex_lock_timeout(&sim_mutex[mi], random_timeout(s)) != 0) return 0;
+
+    SIM_CHECK(mutex_holder[mi] == 0, mutex_holder[mi], id + 1);
+    mutex_holder[mi] = id + 1;
+    // IPCP: ridicat la plafon chiar la lock
+    uint32_t eff = rtos_task_current()->eff_priority;
+    SIM_CHECK(eff >= sim_mutex[mi].ceiling, eff, sim_mutex[mi].ceiling);
+    return 1;
+}
+
+static void mutex_release(uint32_t mi, uint32_t id)
+{
+    SIM_CHECK(mutex_holder[mi] == id + 1, mutex_holder[mi], id + 1);
+    mutex_holder[mi] = 0;
+    rtos_mutex_unlock(&sim_mutex[mi]);
+}
+
+// un singur mutex sau 0 apoi 1 imbricat (lanturi de mostenire pe 2 nivele)
+static void op_mutex(uint32_t id, uint32_t *s)
+{
+    uint32_t first = rnd(s, 3);         // 2 = imbricat
+    uint32_t nested = (first == 2);
+    if (nested) first = 0;
+
+    if (!mutex_take(first, id, s)) return;
+    if (rnd(s, 2)) rtos_delay(1 + rnd(s, 3));
+
+    if (nested && mutex_take(1, id, s)) {
+        if (rnd(s, 2)) rtos_delay(1 + rnd(s, 3));
+        // eliberare in orice ordine: prioritatea se recalculeaza din ce a ramas
+        if (rnd(s, 2)) { mutex_release(1, id); mutex_release(0, id); }
+        else           { mutex_release(0, id); mutex_release(1, id); }
+    } else {
+        mutex_release(first, id);
+    }
+
+    // fara mutex-uri detinute nu mai mosteneste nimic
+    rtos_tcb_t *me = rtos_task_current();
+    SIM_CHECK(me->held_mutexes == NULL && me->held_pending == NULL, 0, 0);
+    SIM_CHECK(me->eff_priority == me->base_priority, me->eff_priority, me->base_priority);
+}
+
+static void op_sem(uint32_t *s)
+{
+    if (rtos_sem_wait_timeout(&sim_sem, random_timeout(s)) != 0) return;
+
+    uint32_t irq = port_enter_critical();
+    sem_held++;
+    port_exit_critical(irq);
+    SIM_CHECK(sem_held <= SIM_SEM_TOKENS, sem_held, SIM_SEM_TOKENS);
+
+    if (rnd(s, 2)) rtos_delay(1 + rnd(s, 4));
+
+    irq = port_enter_critical();
+    sem_held--;
+    port_exit_critical(irq);
+    rtos_sem_signal(&sim_sem);
+}
+
+static void op_queue(uint32_t id, uint32_t *s, uint32_t *seq)
+{
+    uint32_t qi = rnd(s, 2);
+    uint32_t msg = (id << 24) | (seq[qi] & 0x00FFFFFFu);
+
+    if (rtos_queue_send_timeout(&sim_queue[qi], msg, random_timeout(s)) == 0) {
+        seq[qi]++;
+        uint32_t irq = port_enter_critical();
+        q_sent[qi]++;
+        port_exit_critical(irq);
+    }
+}
+
+static void op_pool(uint32_t id, uint32_t *s)
+{
+    uint8_t *b = rtos_pool_alloc(&sim_pool, random_timeout(s));
+    if (b == NULL) return;
+
+    SIM_CHECK(rtos_pool_free_count(&sim_pool) < SIM_POOL_BLOCKS,
+              rtos_pool_free_count(&sim_pool), SIM_POOL_BLOCKS);
+    memset(b, (int)(0xA0u + id), SIM_POOL_BLOCK);
+    b[0] = (uint8_t)id;
+
+    uint32_t irq = port_enter_critical();
+    mbox_posted++;
+    port_exit_critical(irq);
+    rtos_mbox_post(&sim_mbox, b);
+}
+
+// 8 biti: setati / stersi de workeri si de supervisor
+static void op_event(uint32_t *s)
+{
+    uint32_t r = rnd(s, 3);
+    if (r == 0) {
+        rtos_event_set(&sim_events, 1u << rnd(s, 8));
+        return;
+    }
+    if (r == 1 && rnd(s, 4) == 0) {
+        rtos_event_clear(&sim_events, 1u << rnd(s, 8));
+        return;
+    }
+
+    uint32_t bits = 1u + rnd(s, 0xFF);
+    uint32_t opts = rnd(s, 4);          // ANY/ALL x CLEAR
+    uint32_t got;
+    // fara timeout infinit: dupa stop nu mai seteaza nimeni
+    if (rtos_event_wait(&sim_events, bits, opts, &got, rnd(s, 20)) != 0) return;
+
+    if (opts & RTOS_EVENT_WAIT_ALL) SIM_CHECK((got & bits) == bits, got, bits);
+    else SIM_CHECK((got & bits) != 0, got, bits);
+    uint32_t irq = port_enter_critical();
+    event_wakes++;
+    port_exit_critical(irq);
+}
+
+// notificari ca semafor numarator: nimic dat nu se pierde si nu se dubleaza
+static void op_notify(uint32_t *s)
+{
+    if (rnd(s, 8) == 0) {
+        // fara valoare: nu e un give si nu trebuie sa scoata take-ul din asteptare
+        (void)rtos_notify(worker_tcb[rnd(s, nworkers)], 0, RTOS_NOTIFY_NONE);
+        return;
+    }
+    if (rnd(s, 2)) {
+        uint32_t irq = port_enter_critical();
+        notify_given++;
+        port_exit_critical(irq);
+        rtos_notify_give(worker_tcb[rnd(s, nworkers)]);
+        return;
+    }
+
+    // clear = 1 consuma tot ce era acumulat, clear = 0 doar o unitate
+    uint32_t clear = rnd(s, 2);
+    uint32_t to = rnd(s, 20);
+    uint32_t t0 = rtos_now();
+    uint32_t n = rtos_notify_take(clear, to);
+    if (n == 0) {
+        SIM_CHECK(rtos_now() - t0 >= to, rtos_now() - t0, to);     // 0 = doar timeout
+        return;
+    }
+    uint32_t irq = port_enter_critical();
+    notify_taken += clear ? n : 1;
+    port_exit_critical(irq);
+}
+
+// doar worker-ul 0 trimite: un singur producator
+static void op_spsc(uint32_t *s)
+{
+    uint32_t seq = spsc_sent;
+    sim_spsc_item_t it = { seq, seq * 0x9E3779B9u, ~(seq * 0x9E3779B9u) };
+    if (rtos_spsc_send(&sim_spsc, &it, random_timeout(s)) == 0) spsc_sent = seq + 1;
+}
+
+static void op_delay(uint32_t *s)
+{
+    uint32_t d = 1 + rnd(s, 10);
+    uint32_t t0 = rtos_now();
+    rtos_delay(d);
+    SIM_CHECK(rtos_now() - t0 >= d, rtos_now() - t0, d);
+}
+
+void sim_worker(void)
+{
+    uint32_t irq = port_enter_critical();
+    uint32_t id = next_worker_id++;
+    port_exit_critical(irq);
+
+    uint32_t s = seed_mix(sim_seed ^ (0x9E3779B9u * (id + 1)));
+    uint32_t seq[2] = { 0, 0 };
+
+    while (!stop) {
+        switch (rnd(&s, 8)) {
+        case 0: op_mutex(id, &s); break;
+        case 1: op_sem(&s); break;
+        case 2: op_queue(id, &s, seq); break;
+        case 3: op_pool(id, &s); break;
+        case 4: op_delay(&s); break;
+        case 5: op_event(&s); break;
+        case 6: op_notify(&s); break;
+        case 7: if (id == 0) { op_spsc(&s); break; } /* fall through */
+        default: rtos_yield(); rtos_delay(rnd(&s, 2)); break;
+        }
+        ops_done++;
+    }
+
+    irq = port_enter_critical();
+    workers_parked++;
+    port_exit_critical(irq);
+    park();
+}
+
+// ----------------------------------------------
+// Consumatori
+// ----------------------------------------------
+static void queue_consume(uint32_t qi)
+{
+    while (1) {
+        uint32_t msg;
+        if (rtos_queue_receive_timeout(&sim_queue[qi], &msg, 5) == 0) {
+            uint32_t id = msg >> 24;
+            uint32_t seq = msg & 0x00FFFFFFu;
+            SIM_CHECK(id < nworkers, id, nworkers);
+            // FIFO: fiecare producator trimite in ordine
+            SIM_CHECK(seq == q_last_seq[qi][id], seq, q_last_seq[qi][id]);
+            q_last_seq[qi][id] = seq + 1;
+            uint32_t irq = port_enter_critical();
+            q_recv[qi]++;
+            port_exit_critical(irq);
+        } else if (stop && workers_parked == nworkers) {
+            break;
+        }
+    }
+    park();
+}
+
+void sim_queue_consumer0(void) { queue_consume(0); }
+void sim_queue_consumer1(void) { queue_consume(1); }
+
+void sim_spsc_consumer(void)
+{
+    uint32_t s = seed_mix(sim_seed ^ 0x5BD1E995u);
+    while (1) {
+        sim_spsc_item_t it;
+        // fara timeout infinit: dupa stop producatorul nu mai trimite
+        if (rtos_spsc_receive(&sim_spsc, &it, rnd(&s, 20)) == 0) {
+            // FIFO, fara pierderi si fara dubluri
+            SIM_CHECK(it.seq == spsc_recv, it.seq, spsc_recv);
+            SIM_CHECK(it.pattern == it.seq * 0x9E3779B9u && it.inv == ~it.pattern, it.pattern, it.inv);
+            spsc_recv++;
+            SIM_CHECK(rtos_spsc_count(&sim_spsc) <= SIM_SPSC_DEPTH, rtos_spsc_count(&sim_spsc), 0);
+        } else if (stop && workers_parked == nworkers) {
+            break;
+        }
+    }
+    park();
+}
+
+void sim_mbox_consumer(void)
+{
+    while (1) {
+        uint8_t *b = rtos_mbox_fetch(&sim_mbox, 5);
+        if (b != NULL) {
+            uint32_t id = b[0];
+            SIM_CHECK(id < nworkers, id, nworkers);
+            SIM_CHECK(b[SIM_POOL_BLOCK - 1] == (uint8_t)(0xA0u + id), b[SIM_POOL_BLOCK - 1], id);
+            uint32_t irq = port_enter_critical();
+            mbox_fetched++;
+            port_exit_critical(irq);
+            SIM_CHECK(rtos_pool_free(&sim_pool, b) == 0, 0, 0);
+        } else if (stop && workers_parked == nworkers) {
+            break;
+        }
+    }
+    park();
+}
+
+// ----------------------------------------------
+// Task periodic EDF
+// ----------------------------------------------
+// Uneori job-ul ruleaza pana la eliberarea urmatoare: rtos_wait_next_period()
+// ia calea de overrun si muta deadline-ul task-ului READY mai tarziu. Dupa
+// fiecare eliberare un task EDF READY cu deadline mai apropiat ar fi trebuit
+// sa ruleze inaintea lui.
+void sim_edf_periodic(void)
+{
+    uint32_t s = seed_mix(sim_seed ^ 0x27D4EB2Fu);
+    rtos_tcb_t *me = rtos_task_current();
+
+    while (!stop) {
+        rtos_wait_next_period();
+
+#if RTOS_EDF
+        uint32_t irq = port_enter_critical();
+        for (uint32_t i = 0; i < nworkers; i++) {
+            rtos_tcb_t *w = worker_tcb[i];
+            if (w->state != TASK_READY || w->rel_deadline == 0 ||
+                w->eff_priority != RTOS_EDF_PRIORITY) continue;
+            SIM_CHECK((int32_t)(w->deadline - me->deadline) >= 0, w->deadline, me->deadline);
+        }
+        port_exit_critical(irq);
+#endif
+
+        // overrun fortat: ocupa CPU-ul pana la eliberarea urmatoare (tick-uri reale)
+        if (edf_forced_overruns < SIM_EDF_OVERRUNS && rnd(&s, 16) == 0) {
+            edf_forced_overruns++;
+            uint32_t next = me->release + me->period;
+            while ((int32_t)(rtos_now() - next) < 0) { }
+        }
+    }
+    park();
+}
+
+// ----------------------------------------------
+// Timere
+// ----------------------------------------------
+// fara RTOS_TIMER_TASK callback-urile ruleaza in tick ISR: folosesc variantele _from_isr
+// (merg si din daemon, in context de thread)
+static void timer_cb0(void)
+{
+    uint32_t woken = 0;
+    timer_count[0]++;
+    rtos_event_set_from_isr(&sim_events, 1u << (timer_count[0] & 7u), &woken);
+    rtos_yield_from_isr(woken);
+}
+
+static void timer_cb1(void)
+{
+    uint32_t woken = 0;
+    timer_count[1]++;
+    notify_given++;
+    rtos_notify_give_from_isr(worker_tcb[timer_count[1] % nworkers], &woken);
+    rtos_yield_from_isr(woken);
+}
+
+static void timer_cb2(void) { timer_count[2]++; }
+static void (*const timer_cb[SIM_TIMERS])(void) = { timer_cb0, timer_cb1, timer_cb2 };
+
+// cate expirari are timer-ul i de la ultimul start pana la tick-ul now
+static uint32_t timer_expected(uint32_t i, uint32_t now)
+{
+    if (timer_stopped[i]) return 0;
+    uint32_t elapsed = now - timer_start_tick[i];
+    uint32_t p = sim_timer[i].period_ticks;
+    return (sim_timer[i].mode == RTOS_TIMER_AUTO_RELOAD) ? elapsed / p : (elapsed >= p);
+}
+
+// s != NULL: intai, uneori, un timer ales aleator e repornit sau oprit
+static void check_timers(uint32_t *s)
+{
+    // dupa restart / stop expirarile vechi nu mai au voie sa ruleze: numaratoarea
+    // o ia de la 0. Cu daemon, expirarile din tick-ul curent sunt inca in coada
+    // (supervisorul a fost eliberat in acelasi tick, inaintea daemon-ului).
+    if (s && rnd(s, 8) == 0) {
+        uint32_t i = rnd(s, SIM_TIMERS);
+        uint32_t irq = port_enter_critical();
+        timer_stopped[i] = (rnd(s, 4) == 0);
+        if (timer_stopped[i]) rtos_timer_stop(&sim_timer[i]);
+        else rtos_timer_start(&sim_timer[i]);
+        timer_count[i] = 0;
+        timer_start_tick[i] = rtos_now();
+        port_exit_critical(irq);
+    }
+
+#if RTOS_TIMER_TASK
+    // daemon-ul are aceeasi prioritate: tot ce a expirat pana la t_queued e deja
+    // in coada lui, iar yield il lasa s-o goleasca; tick-urile de dupa pot fi
+    // inca nerulate
+    uint32_t t_queued = rtos_now();
+    rtos_yield();
+#endif
+    uint32_t irq = port_enter_critical();
+    uint32_t now = rtos_now();
+#if !RTOS_TIMER_TASK
+    uint32_t t_queued = now;                // callback-urile ruleaza chiar in tick
+#endif
+    for (uint32_t i = 0; i < SIM_TIMERS; i++) {
+        uint32_t lo = timer_expected(i, t_queued);
+        uint32_t hi = timer_expected(i, now);
+        SIM_CHECK(timer_count[i] >= lo && timer_count[i] <= hi, timer_count[i], lo);
+    }
+    port_exit_critical(irq);
+}
+
+// ----------------------------------------------
+// Supervisor
+// ----------------------------------------------
+#if RTOS_TASK_STATS
+// port_cycles() pe 64 de biti: pe host TSC-ul trece de 2^32 in ~1.4 s (fara
+// tickless idle scenariul ruleaza in timp real); esantionat de supervisor la
+// fiecare perioada, deci niciun wrap nu e ratat
+static uint64_t sim_cycles64(void)
+{
+    static uint32_t last;
+    static uint64_t high;
+    uint32_t irq = port_enter_critical();
+    uint32_t now = port_cycles();
+    if (now < last) high += 1ull << 32;
+    last = now;
+    uint64_t c = high | now;
+    port_exit_critical(irq);
+    return c;
+}
+#endif
+
+static void check_invariants(uint32_t *s)
+{
+    uint32_t irq = port_enter_critical();
+    SIM_CHECK(sem_held + sim_sem.count <= SIM_SEM_TOKENS, sem_held, sim_sem.count);
+    SIM_CHECK(rtos_pool_free_count(&sim_pool) <= SIM_POOL_BLOCKS,
+              rtos_pool_free_count(&sim_pool), SIM_POOL_BLOCKS);
+
+    // mostenirea prioritatii (tranzitiva): fiecare detinator ruleaza exact la
+    // max(base, plafoanele si cel mai urgent waiter al mutex-urilor detinute), si
+    // un waiter ridicat ridica mai departe detinatorul mutex-ului pe care asteapta
+    for (uint32_t mi = 0; mi < 2; mi++) {
+        rtos_tcb_t *owner = rtos_mutex_owner(&sim_mutex[mi]);
+        if (owner == NULL) continue;
+        uint32_t p = owner->base_priority;
+        // dupa cuvantul lock, nu dupa held_mutexes: worker-ul poate fi oprit la
+        // mijlocul cai rapide, cu mutex-ul luat dar inca nelegat in lista
+        for (uint32_t k = 0; k < 2; k++) {
+            rtos_mutex_t *m = &sim_mutex[k];
+            if (rtos_mutex_owner(m) != owner) continue;
+            if (m->ceiling > p) p = m->ceiling;
+            if (m->waiters.head && m->waiters.head->eff_priority > p) p = m->waiters.head->eff_priority;
+        }
+        SIM_CHECK(owner->eff_priority == p, owner->eff_priority, p);
+    }
+
+    // set-ul evalueaza toti waiter-ii: niciunul nu ramane blocat cu conditia indeplinita
+    for (rtos_tcb_t *t = sim_events.waiters.head; t; t = t->wait_next) {
+        uint32_t m = sim_events.bits & t->event_bits;
+        SIM_CHECK((t->event_opts & RTOS_EVENT_WAIT_ALL) ? m != t->event_bits : m == 0,
+                  sim_events.bits, t->event_bits);
+    }
+    port_exit_critical(irq);
+
+    check_timers(s);
+}
+
+void sim_supervisor(void)
+{
+    uint32_t s = seed_mix(sim_seed);
+
+    uint32_t irq = port_enter_critical();
+    for (uint32_t i = 0; i < SIM_TIMERS; i++) {
+        rtos_timer_init_mode(&sim_timer[i], 1 + rnd(&s, 40), timer_cb[i],
+                             rnd(&s, 3) ? RTOS_TIMER_AUTO_RELOAD : RTOS_TIMER_ONE_SHOT);
+        timer_start_tick[i] = rtos_now();
+        rtos_timer_start(&sim_timer[i]);
+    }
+    port_exit_critical(irq);
+
+#if RTOS_TASK_STATS
+    // fereastra de masurare: fiecare ciclu trebuie atribuit exact unui task
+    uint64_t c_pre = sim_cycles64();
+    rtos_reset_task_stats();
+    uint64_t c_post = sim_cycles64();
+#endif
+
+    // task periodic: verificarile ruleaza pe grila release_k = k * SIM_CHECK_PERIOD
+    uint32_t t_end = rtos_now() + sim_ticks;
+    while ((int32_t)(rtos_now() - t_end) < 0) {
+        SIM_CHECK(rtos_wait_next_period() == 0, 0, 0);
+        check_invariants(&s);
+        rtos_event_set(&sim_events, (1u << rnd(&s, 8)) | (1u << rnd(&s, 8)));
+#if RTOS_TASK_STATS
+        (void)sim_cycles64();
+#endif
+    }
+
+    // prioritatea maxima si job-uri scurte: pornit in tick-ul eliberarii, niciun overrun
+    rtos_periodic_stats_t st;
+    SIM_CHECK(rtos_task_get_periodic_stats(rtos_task_current(), &st) == 0, 0, 0);
+    SIM_CHECK(st.worst_jitter <= 1, st.worst_jitter, 1);
+    SIM_CHECK(st.misses == 0 && st.overruns == 0, st.misses, st.overruns);
+    SIM_CHECK(st.jobs >= sim_ticks / SIM_CHECK_PERIOD, st.jobs, sim_ticks / SIM_CHECK_PERIOD);
+
+    // oprire: toate task-urile trebuie sa ajunga in park (altfel e un wake-up pierdut)
+    stop = 1;
+    uint32_t waited = 0;
+    while (parked < nworkers + SIM_CONSUMERS && waited < SIM_DRAIN_TICKS) {
+        rtos_delay(10);
+        waited += 10;
+#if RTOS_TASK_STATS
+        (void)sim_cycles64();
+#endif
+    }
+    SIM_CHECK(parked == nworkers + SIM_CONSUMERS, parked, nworkers + SIM_CONSUMERS);
+
+    check_invariants(NULL);
+    for (uint32_t mi = 0; mi < 2; mi++) {
+        SIM_CHECK(sim_mutex[mi].lock == 0 && sim_mutex[mi].waiters.head == NULL, sim_mutex[mi].lock, mi);
+    }
+    SIM_CHECK(sim_sem.count == SIM_SEM_TOKENS, sim_sem.count, SIM_SEM_TOKENS);
+    SIM_CHECK(q_sent[0] == q_recv[0], q_sent[0], q_recv[0]);
+    SIM_CHECK(q_sent[1] == q_recv[1], q_sent[1], q_recv[1]);
+    SIM_CHECK(mbox_posted == mbox_fetched, mbox_posted, mbox_fetched);
+    SIM_CHECK(spsc_sent == spsc_recv && rtos_spsc_count(&sim_spsc) == 0, spsc_sent, spsc_recv);
+    SIM_CHECK(rtos_pool_free_count(&sim_pool) == SIM_POOL_BLOCKS,
+              rtos_pool_free_count(&sim_pool), SIM_POOL_BLOCKS);
+    SIM_CHECK(sim_events.waiters.head == NULL, 0, 0);
+    uint32_t notify_left = 0;
+    for (uint32_t i = 0; i < nworkers; i++) notify_left += worker_tcb[i]->notify_value;
+    SIM_CHECK(notify_taken + notify_left == notify_given, notify_taken + notify_left, notify_given);
+
+#if RTOS_TASK_STATS
+    static rtos_task_stats_t snap[RTOS_MAX_TASKS];
+    uint64_t total;
+    uint64_t c_before = sim_cycles64();
+    uint32_t n = rtos_get_task_stats(snap, RTOS_MAX_TASKS, &total);
+    uint64_t c_after = sim_cycles64();
+    SIM_CHECK(n == nworkers + SIM_CONSUMERS + 2 + RTOS_TIMER_TASK,
+              n, nworkers + SIM_CONSUMERS + 2 + RTOS_TIMER_TASK);
+    SIM_CHECK(total >= c_before - c_post && total <= c_after - c_pre,
+              (uint32_t)(total >> 20), (uint32_t)((c_before - c_post) >> 20));
+    if (sim_verbose) rtos_dump_task_stats();
+#endif
+
+    if (sim_verbose) {
+        printf("seed=%u workers=%u ticks=%u ops=%u queue=%u/%u mbox=%u spsc=%u events=%u notify=%u cs=%u\n",
+               sim_seed, nworkers, rtos_now(), ops_done, q_recv[0], q_recv[1],
+               mbox_fetched, spsc_recv, event_wakes, notify_taken, rtos_get_context_switch_cycles());
+        fflush(stdout);
+    }
+    _exit(0);
+}
+
+void sim_idle(void)
+{
+    while (1) rtos_idle_sleep();
+}
+
+// ----------------------------------------------
+// Un scenariu (in procesul copil)
+// ----------------------------------------------
+static void run_scenario(void)
+{
+    uint32_t s = seed_mix(sim_seed);
+    struct rlimit rl = { SIM_CPU_LIMIT_S, SIM_CPU_LIMIT_S };
+    setrlimit(RLIMIT_CPU, &rl);    // watchdog pentru livelock
+
+    uart_init();
+    rtos_init();
+#if RTOS_DEBUG
+    rtos_set_assert_hook(sim_assert);
+#endif
+    rtos_mutex_init(&sim_mutex[0]);
+    rtos_sem_init(&sim_sem, SIM_SEM_TOKENS);
+    rtos_queue_init(&sim_queue[0]);
+    rtos_queue_init(&sim_queue[1]);
+    rtos_pool_init(&sim_pool, sim_pool_storage, SIM_POOL_BLOCK, SIM_POOL_BLOCKS);
+    rtos_mbox_init(&sim_mbox);
+    rtos_event_init(&sim_events);
+    rtos_spsc_init(&sim_spsc, sim_spsc_buf, sizeof(sim_spsc_item_t), SIM_SPSC_DEPTH);
+
+    nworkers = 2 + rnd(&s, SIM_MAX_WORKERS - 1);
+    for (uint32_t i = 0; i < nworkers; i++) {
+        worker_prio[i] = 1 + rnd(&s, RTOS_MAX_PRIORITIES - 3);
+    }
+
+    rtos_task_set_name(rtos_task_create(sim_idle, 0), "idle");
+    rtos_task_set_name(rtos_task_create_periodic(sim_supervisor, RTOS_MAX_PRIORITIES - 1,
+                                                 SIM_CHECK_PERIOD, 0, 0), "supervisor");
+    rtos_task_create(sim_queue_consumer0, 1 + rnd(&s, RTOS_MAX_PRIORITIES - 3));
+    rtos_task_create(sim_queue_consumer1, 1 + rnd(&s, RTOS_MAX_PRIORITIES - 3));
+    rtos_task_create(sim_mbox_consumer, 1 + rnd(&s, RTOS_MAX_PRIORITIES - 3));
+    rtos_task_create(sim_spsc_consumer, 1 + rnd(&s, RTOS_MAX_PRIORITIES - 3));
+    rtos_task_set_name(rtos_task_create_periodic(sim_edf_periodic, RTOS_EDF_PRIORITY,
+                                                 2 + rnd(&s, 3), 1, 0), "edf-periodic");
+    for (uint32_t i = 0; i < nworkers; i++) {
+#if RTOS_EDF
+        // o parte din workeri in clasa EDF, deasupra celor cu prioritate fixa
+        if (rnd(&s, 4) == 0) {
+            worker_tcb[i] = rtos_task_create_edf(sim_worker, 5 + rnd(&s, 50));
+            continue;
+        }
+#endif
+        worker_tcb[i] = rtos_task_create(sim_worker, worker_prio[i]);
+    }
+
+    // plafonul IPCP = cea mai mare prioritate de baza dintre cei care il folosesc
+    uint32_t ceiling = 0;
+    for (uint32_t i = 0; i < nworkers; i++) {
+        if (worker_tcb[i]->base_priority > ceiling) ceiling = worker_tcb[i]->base_priority;
+    }
+    if (rnd(&s, 2)) rtos_mutex_init_ceiling(&sim_mutex[1], ceiling);
+    else rtos_mutex_init(&sim_mutex[1]);
+
+    rtos_start();
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "utilizare: %s [-n runs] [-s seed] [-t ticks] [-v]\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t runs = 100;
+    uint32_t seed = (uint32_t)time(NULL);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:t:v")) != -1) {
+        switch (opt) {
+        case 'n': runs = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 't': sim_ticks = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'v': sim_verbose = 1; break;
+        default: usage(argv[0]);
+        }
+    }
+
+    uint32_t failed = 0;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    for (uint32_t i = 0; i < runs; i++) {
+        sim_seed = seed + i;
+
+        pid_t pid = fork();
+        if (pid < 0) { perror("fork"); return 2; }
+        if (pid == 0) {
+            run_scenario();
+            _exit(3);
+        }
+
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed++;
+            if (WIFSIGNALED(status)) {
+                fprintf(stderr, "FAIL seed=%u: semnal %d\n", sim_seed, WTERMSIG(status));
+            }
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double secs = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    printf("runs=%u failed=%u seed=%u ticks=%u time=%.2fs\n", runs, failed, seed, sim_ticks, secs);
+    return failed ? 1 : 0;
+}
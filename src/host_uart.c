@@ -0,0 +1,117 @@
+#include "uart.h"
+#include "port.h"
+
+#include <unistd.h>
+
+// ----------------------------------------------
+// UART pentru build-ul de host: iesirea merge pe stdout
+// ----------------------------------------------
+// Acelasi API ca uart.c, ca rtos_stats.c / bench.c sa se compileze neschimbate.
+// Linie bufferizata, scrisa cu write(2) la '\n'; sectiunea critica impiedica
+// un alt task sa intercaleze caractere in aceeasi linie.
+
+#define HOST_LINE_MAX 256
+
+static char line_buf[HOST_LINE_MAX];
+static uint32_t line_len = 0;
+
+static void line_flush(void)
+{
+    uint32_t off = 0;
+    while (off < line_len) {
+        ssize_t n = write(STDOUT_FILENO, line_buf + off, line_len - off);
+        if (n <= 0) break;
+        off += (uint32_t)n;
+    }
+    line_len = 0;
+}
+
+static void line_putc(char c)
+{
+    line_buf[line_len++] = c;
+    if (c == '\n' || line_len == HOST_LINE_MAX) line_flush();
+}
+
+void uart_init(void)
+{
+    line_len = 0;
+}
+
+void uart_putc(char c)
+{
+    uint32_t irq = port_enter_critical();
+    line_putc(c);
+    port_exit_critical(irq);
+}
+
+void uart_puts(const char *s)
+{
+    uint32_t irq = port_enter_critical();
+    while (*s) line_putc(*s++);     // fara '\r' pe terminal
+    port_exit_critical(irq);
+}
+
+uint32_t uart_write(const char *buf, uint32_t len)
+{
+    uint32_t irq = port_enter_critical();
+    for (uint32_t i = 0; i < len; i++) line_putc(buf[i]);
+    port_exit_critical(irq);
+    return len;
+}
+
+void uart_print_uint(uint32_t val)
+{
+    char buf[12];
+    int i = 0;
+
+    if (val == 0) { uart_putc('0'); return; }
+
+    while (val > 0) {
+        buf[i++] = '0' + (val % 10);
+        val /= 10;
+    }
+
+    uint32_t irq = port_enter_critical();
+    while (i > 0) line_putc(buf[--i]);
+    port_exit_critical(irq);
+}
+
+void uart_print_hex(uint32_t val)
+{
+    const char hex[] = "0123456789ABCDEF";
+
+    uint32_t irq = port_enter_critical();
+    line_putc('0');
+    line_putc('x');
+    for (int i = 7; i >= 0; i--) {
+        line_putc(hex[(val >> (i * 4)) & 0xF]);
+    }
+    port_exit_critical(irq);
+}
+
+uint32_t uart_tx_dropped(void)
+{
+    return 0;
+}
+
+// fara RX pe host: asteapta timeout-ul si intoarce 0 octeti
+uint32_t uart_read(uint8_t *buf, uint32_t max, uint32_t trigger, int delim, uint32_t timeout_ticks)
+{
+    (void)buf; (void)max; (void)trigger; (void)delim;
+    if (timeout_ticks != 0 && timeout_ticks != 0xFFFFFFFFu) rtos_delay(timeout_ticks);
+    return 0;
+}
+
+uint32_t uart_rx_available(void)
+{
+    return 0;
+}
+
+uint32_t uart_rx_overflows(void)
+{
+    return 0;
+}
+
+void USART1_IRQHandler(void)
+{
+}
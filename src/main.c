@@ -9,18 +9,8 @@
 
 extern uint32_t rtos_now();
 
-// ----------------------------------------------
-// SysTick
-// ----------------------------------------------
-#define SYST_CSR   (*(volatile uint32_t *)0xE000E010)
-#define SYST_RVR   (*(volatile uint32_t *)0xE000E014)
-#define SYST_CVR   (*(volatile uint32_t *)0xE000E018)
 #define SCB_VTOR   (*(volatile uint32_t *)0xE000ED08)
 
-#define SYST_CSR_ENABLE      (1u << 0)
-#define SYST_CSR_TICKINT     (1u << 1)
-#define SYST_CSR_CLKSOURCE   (1u << 2)
-
 
 extern volatile uint32_t g_pi_enabled;
 // ----------------------------------------------
@@ -61,18 +51,6 @@ volatile uint32_t t1_deadline_misses = 0;
 volatile uint32_t t2_executions = 0;
 volatile uint32_t t2_deadline_misses = 0;
 
-void systick_init()
-{
-    uint32_t reload = (CPU_CLOCK_HZ / RTOS_TICK_RATE_HZ) - 1u;
-    if(reload > 0x00FFFFFFu){
-        while(1){}
-    }
-
-    SYST_RVR = reload;
-    SYST_CVR = 0u;
-    SYST_CSR = SYST_CSR_ENABLE | SYST_CSR_TICKINT | SYST_CSR_CLKSOURCE;
-}
-
 // ----------------------------------------------
 // GPIO Initialization
 // ----------------------------------------------
@@ -133,9 +111,44 @@ void task_consumator(void) {
 // ----------------------------------------------
 // Task-uri RMS
 // ----------------------------------------------
+// Eliberarile, deadline-urile si miss-urile sunt gestionate de kernel
+// (rtos_task_create_periodic / rtos_wait_next_period)
+rtos_tcb_t *rms_t1 = NULL;
+rtos_tcb_t *rms_t2 = NULL;
+
+static void rms_print(const char *name, rtos_tcb_t *t)
+{
+    rtos_periodic_stats_t st;
+    if (rtos_task_get_periodic_stats(t, &st) != 0) return;
+
+    uart_puts(name);
+    uart_puts(" Exec=");
+    uart_print_uint(st.jobs);
+    uart_puts(" Misses=");
+    uart_print_uint(st.misses);
+    uart_puts(" Overruns=");
+    uart_print_uint(st.overruns);
+    uart_puts(" WorstResp=");
+    uart_print_uint(st.worst_response);
+    uart_puts(" WorstJitter=");
+    uart_print_uint(st.worst_jitter);
+    uart_puts("\n");
+}
+
+// apelat din task-ul care si-a ratat deadline-ul
+static void rms_deadline_miss(rtos_tcb_t *t)
+{
+    if (t == rms_t1) {
+        t1_deadline_misses++;
+        uart_puts("[T1] DEADLINE MISS!\n");
+    } else if (t == rms_t2) {
+        t2_deadline_misses++;
+        uart_puts("[T2] DEADLINE MISS!\n");
+    }
+}
+
 // T1: perioadă 5ms, execuție ~1ms, prioritate MARE
 void task_rms_t1(void) {
-    uint32_t next_release = rtos_now() + 5;
     uint32_t count = 0;
 
     while(1) {
@@ -145,33 +158,18 @@ void task_rms_t1(void) {
         while(rtos_now() - start < 1);
         
         t1_executions++;
-        
-        // Verifică deadline
-        if(rtos_now() > next_release) {
-            t1_deadline_misses++;
-            uart_puts("[T1] DEADLINE MISS!\n");
-        }
-        
-         if(++count >= 100) {
-            uart_puts("[T1] Exec=");
-            uart_print_uint(t1_executions);
-            uart_puts(" Misses=");
-            uart_print_uint(t1_deadline_misses);
-            uart_puts("\n");
+
+        if(++count >= 100) {
+            rms_print("[T1]", rms_t1);
             count = 0;
         }
 
-        uint32_t now = rtos_now();
-        if(now < next_release) {
-            rtos_delay(next_release - now);
-        }
-        next_release += 5;
+        rtos_wait_next_period();
     }
 }
 
 // T2: perioadă 20ms, execuție ~2ms, prioritate MEDIE
 void task_rms_t2(void) {
-    uint32_t next_release = rtos_now() + 20;
     uint32_t count = 0;
 
     while(1) {
@@ -181,27 +179,13 @@ void task_rms_t2(void) {
         while(rtos_now() - start < 2);
         
         t2_executions++;
-        
-        // Verifică deadline
-        if(rtos_now() > next_release) {
-            t2_deadline_misses++;
-            uart_puts("[T2] DEADLINE MISS!\n");
-        }
-        
+
         if(++count >= 25) {
-            uart_puts("[T2] Exec=");
-            uart_print_uint(t2_executions);
-            uart_puts(" Misses=");
-            uart_print_uint(t2_deadline_misses);
-            uart_puts("\n");
+            rms_print("[T2]", rms_t2);
             count = 0;
         }
 
-        uint32_t now = rtos_now();
-        if(now < next_release) {
-            rtos_delay(next_release - now);
-        }
-        next_release += 20;
+        rtos_wait_next_period();
     }
 }
 
@@ -306,6 +290,9 @@ void idle_task(void) {
             }
         }
         last_tick = now;
+
+        // nimic altceva de rulat: doarme pana la urmatorul eveniment
+        rtos_idle_sleep();
     }
 }
 
@@ -348,12 +335,13 @@ int main(){
     uart_puts("Creating tasks...\n");
 
     // Creare task-uri (prioritate crescătoare)
-    rtos_task_create(idle_task, 0);           // Prioritate minimă
-    rtos_task_create(task_gpio_blink, 1);     // Prioritate joasă - blink task
-    rtos_task_create(task_producator, 2);     // Prioritate medie
-    rtos_task_create(task_consumator, 3);     // Prioritate medie-înaltă
-    //rtos_task_create(task_rms_t2, 4);         // T2 = 20ms → prioritate mare
-    //rtos_task_create(task_rms_t1, 5);         // T1 = 5ms → prioritate maximă
+    rtos_task_set_name(rtos_task_create(idle_task, 0), "idle");              // Prioritate minimă
+    rtos_task_set_name(rtos_task_create(task_gpio_blink, 1), "blink");       // Prioritate joasă - blink task
+    rtos_task_set_name(rtos_task_create(task_producator, 2), "producator");  // Prioritate medie
+    rtos_task_set_name(rtos_task_create(task_consumator, 3), "consumator");  // Prioritate medie-înaltă
+    //rms_t2 = rtos_task_create_periodic(task_rms_t2, 4, 20, 0, 0);  // T2 = 20ms → prioritate mare
+    //rms_t1 = rtos_task_create_periodic(task_rms_t1, 5, 5, 0, 0);   // T1 = 5ms → prioritate maximă
+    rtos_set_deadline_miss_hook(rms_deadline_miss);
 
     //rtos_task_create(task_pi_low_owner, 1);
     //rtos_task_create(task_pi_medium_hog, 3);
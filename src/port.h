@@ -0,0 +1,109 @@
+#ifndef PORT_H
+#define PORT_H
+
+#include <stdint.h>
+#include "rtos.h"
+
+// ----------------------------------------------
+// Port layer: tot ce depinde de CPU / platforma
+// ----------------------------------------------
+// port_cm3.c   - Cortex-M3 (PendSV, SysTick, DWT), implicit
+// port_posix.c - simulare pe Linux (ucontext + SIGALRM), cu -DRTOS_PORT_POSIX
+
+// furnizate de kernel pentru port
+extern rtos_tcb_t *current_task;
+void rtos_cs_record(uint32_t cycles);  // costul unui context switch masurat de port
+
+void port_init(void);                   // prioritati exceptii, contor de cicluri
+uint32_t *port_init_stack(uint32_t *stack, uint32_t size_words, void (*task_fn)(void));
+void port_start_scheduler(void);        // porneste tick-ul si primul task; nu se intoarce
+// doarme cel mult expected_ticks, apelat in sectiune critica; intoarce cate tick-uri
+// intregi au trecut si trebuie adaugate la g_tick (ultimul e numarat de tick ISR).
+// *slept_cycles = cicluri petrecute efectiv in somn, inclusiv tick-ul partial
+// la o trezire mai devreme (port_cycles() nu le vede daca PORT_CYCLES_STOP_IN_SLEEP)
+uint32_t port_tickless_sleep(uint32_t expected_ticks, uint32_t *slept_cycles);
+
+// Sectiune critica cu salvare/restaurare (se poate imbrica, si din ISR):
+//     uint32_t irq = port_enter_critical();
+//     ...
+//     port_exit_critical(irq);
+// Pe Cortex-M3 ridica BASEPRI la RTOS_MAX_SYSCALL_PRIORITY: intreruperile mai
+// urgente nu sunt mascate niciodata de kernel (si nu au voie sa il apeleze).
+//
+// port_cas(p, expected, desired): compare-and-swap pe 32 de biti, 1 daca *p era
+// expected si acum e desired. Atomic fata de ISR-uri si de context switch, fara
+// sectiune critica (caile rapide pentru mutex / semafor necontestate).
+
+#ifdef RTOS_PORT_POSIX
+
+uint32_t port_enter_critical(void);
+void port_exit_critical(uint32_t saved);
+void port_yield(void);
+uint32_t port_cycles(void);
+#define port_memory_barrier() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+static inline int port_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#define PORT_CYCLES_STOP_IN_SLEEP 0     // somnul tickless e instantaneu (timp virtual)
+
+#else
+
+#define DWT_CYCCNT   (*(volatile uint32_t *)0xE0001004)
+#define PORT_CYCLES_STOP_IN_SLEEP 1     // CYCCNT sta pe loc in WFI (ceasul core-ului e oprit)
+
+#if RTOS_MAX_SYSCALL_PRIORITY == 0
+#error "RTOS_MAX_SYSCALL_PRIORITY 0 nu mascheaza nimic (BASEPRI = 0 inseamna dezactivat)"
+#endif
+
+static inline uint32_t port_enter_critical(void)
+{
+    uint32_t saved;
+    __asm volatile("mrs %0, basepri" : "=r"(saved));
+    // basepri_max doar ridica masca: imbricat intr-o sectiune mai stricta nu o coboara
+    __asm volatile("msr basepri_max, %0 \n isb" : : "r"(RTOS_MAX_SYSCALL_PRIORITY) : "memory");
+    return saved;
+}
+
+static inline void port_exit_critical(uint32_t saved)
+{
+    __asm volatile("msr basepri, %0 \n isb" : : "r"(saved) : "memory");
+}
+
+// cere un context switch: PendSV ruleaza cand nu mai e nicio alta exceptie activa
+static inline void port_yield(void)
+{
+    SCB_ICSR = SCB_ICSR_PENDSVSET;
+}
+
+static inline uint32_t port_cycles(void)
+{
+    return DWT_CYCCNT;
+}
+
+static inline void port_memory_barrier(void)
+{
+    __asm volatile("dmb" : : : "memory");
+}
+
+// LDREX/STREX: intrarea / iesirea dintr-o exceptie sterge monitorul local, deci
+// STREX esueaza daca intre cele doua a rulat un ISR sau PendSV. Un singur core:
+// nu e nevoie de DMB, "memory" tine compilatorul pe loc.
+static inline int port_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired)
+{
+    uint32_t cur, fail;
+    do {
+        __asm volatile("ldrex %0, [%1]" : "=r"(cur) : "r"(p) : "memory");
+        if (cur != expected) {
+            __asm volatile("clrex" : : : "memory");
+            return 0;
+        }
+        __asm volatile("strex %0, %2, [%1]" : "=&r"(fail) : "r"(p), "r"(desired) : "memory");
+    } while (fail);
+    return 1;
+}
+
+#endif
+
+#endif
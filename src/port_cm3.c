@@ -0,0 +1,237 @@
+#include "port.h"
+
+// ----------------------------------------------
+// Port Cortex-M3
+// ----------------------------------------------
+// DWT (Data Watchpoint and Trace) pentru măsurare cicluri
+#define DWT_CTRL     (*(volatile uint32_t *)0xE0001000)
+#define DEM_CR       (*(volatile uint32_t *)0xE000EDFC)
+
+#define DEM_CR_TRCENA (1 << 24)
+#define DWT_CTRL_CYCCNTENA (1 << 0)
+
+#define SCB_SHPR3 (*(volatile uint32_t *)0xE000ED20)
+#define SYSTICK_PRIO 0x80
+#define PENDSV_PRIO  0xFF
+
+// SysTick si PendSV intra in kernel: trebuie mascate de sectiunile critice
+#if SYSTICK_PRIO < RTOS_MAX_SYSCALL_PRIORITY
+#error "SysTick trebuie sa aiba prioritate numerica >= RTOS_MAX_SYSCALL_PRIORITY"
+#endif
+
+#define PORT_STR_(x) #x
+#define PORT_STR(x) PORT_STR_(x)
+#define SCB_ICSR_PENDSTSET (1UL << 26)
+
+// SysTick
+#define SYST_CSR   (*(volatile uint32_t *)0xE000E010)
+#define SYST_RVR   (*(volatile uint32_t *)0xE000E014)
+#define SYST_CVR   (*(volatile uint32_t *)0xE000E018)
+
+#define SYST_CSR_ENABLE      (1u << 0)
+#define SYST_CSR_TICKINT     (1u << 1)
+#define SYST_CSR_CLKSOURCE   (1u << 2)
+#define SYST_TICK_CYCLES     (CPU_CLOCK_HZ / RTOS_TICK_RATE_HZ)
+
+// scris din PendSV_Handler (asm), de aceea "used"
+__attribute__((used)) static volatile uint32_t cs_entry_cycles = 0;
+
+static void set_exception_priorities()
+{
+    // Setează PendSV la 255 (cea mai mică) și SysTick la ceva mai mare (ex. 128)
+    SCB_SHPR3 = (PENDSV_PRIO << 16) | (SYSTICK_PRIO << 24);
+}
+
+// Functie pentru initializare DWT
+static void dwt_init(void) {
+    // Enable trace
+    DEM_CR |= DEM_CR_TRCENA;
+    
+    // Reset counter
+    DWT_CYCCNT = 0;
+    
+    // Enable counter
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+static void systick_init()
+{
+    uint32_t reload = SYST_TICK_CYCLES - 1u;
+    if(reload > 0x00FFFFFFu){
+        while(1){}
+    }
+
+    SYST_RVR = reload;
+    SYST_CVR = 0u;
+    SYST_CSR = SYST_CSR_ENABLE | SYST_CSR_TICKINT | SYST_CSR_CLKSOURCE;
+}
+
+void port_init(void)
+{
+    set_exception_priorities();
+    dwt_init();
+}
+
+uint32_t *port_init_stack(uint32_t *stack, uint32_t size, void (*task_fn)(void))
+{
+    stack[size - 1] = 0x01000000;           // xPSR (thumb bit = 1)
+    stack[size - 2] = (uint32_t)task_fn | 0x01;  // PC = functia task-ului
+    stack[size - 3] = 0xFFFFFFFD;           // LR pentru thread mode cu PSP (stiva separata)
+    stack[size - 4] = 0;                    // R12
+    stack[size - 5] = 0;                    // R3
+    stack[size - 6] = 0;                    // R2
+    stack[size - 7] = 0;                    // R1
+    stack[size - 8] = 0;                    // R0
+
+    // context software (R4..R11) va fi salvat/restaurat ulterior
+    return &stack[size - 16];
+}
+
+void port_start_scheduler(void)
+{
+    __asm volatile("mov r0, #0 \n msr psp, r0"); // Spune-i lui PendSV că e prima rulare
+    
+    set_exception_priorities();
+    systick_init();
+    
+    // PRIMASK (setat in main) nu mai e folosit de kernel: de aici doar BASEPRI
+    port_exit_critical(0);
+    __asm volatile("cpsie i" : : : "memory"); 
+
+    port_yield();
+    while (1) { /* nimic */ }
+}
+
+// ----------------------------------------------
+// Tickless idle: SysTick reprogramat pana la urmatorul eveniment
+// ----------------------------------------------
+// apelat in sectiune critica (BASEPRI ridicat)
+uint32_t port_tickless_sleep(uint32_t expected, uint32_t *slept_cycles)
+{
+    *slept_cycles = 0;
+
+    uint32_t max_ticks = 0x00FFFFFFu / SYST_TICK_CYCLES;
+    if (expected > max_ticks) expected = max_ticks;
+
+    // cat SysTick sta oprit (oprire -> reprogramare -> pornire) timpul trece
+    // totusi: il masuram cu port_cycles(). SysTick numara pe ceasul core-ului
+    // (CLKSOURCE = 1), deci ciclii DWT sunt exact numaratori SysTick, la orice
+    // frecventa; necompensate raman doar cele cateva store-uri de dupa citire
+    uint32_t stopped_at = port_cycles();
+    SYST_CSR &= ~SYST_CSR_ENABLE;
+
+    // SYST_CVR = cicluri pana la granita tick-ului curent; apoi expected-1 perioade intregi
+    uint32_t reload = SYST_CVR + SYST_TICK_CYCLES * (expected - 1u);
+    uint32_t stopped = port_cycles() - stopped_at;
+
+    // un tick a expirat chiar acum (sau e prea aproape) -> renuntam, il proceseaza SysTick_Handler
+    if ((SCB_ICSR & SCB_ICSR_PENDSTSET) || reload <= stopped + 2u) {
+        SYST_CSR |= SYST_CSR_ENABLE;
+        return 0;
+    }
+
+    // timpul cat a stat oprit a trecut deja; RVR = N-1 da o perioada de N cicluri
+    reload -= stopped;
+    SYST_RVR = reload - 1u;
+    SYST_CVR = 0u;
+    SYST_CSR |= SYST_CSR_ENABLE;
+    uint32_t started_at = port_cycles();
+
+    // WFI nu se trezeste la intreruperi mascate de BASEPRI: il coboram doar pe
+    // durata somnului, cu PRIMASK setat intreruperea ramane pending pana mai jos
+    uint32_t basepri;
+    __asm volatile("mrs %0, basepri" : "=r"(basepri));
+    __asm volatile("cpsid i             \n"
+                   "msr   basepri, %0   \n"
+                   "dsb                 \n"
+                   "wfi                 \n"
+                   "isb                 \n"
+                   "msr   basepri, %1   \n"
+                   "cpsie i             \n"
+                   : : "r"(0u), "r"(basepri) : "memory");
+
+    stopped_at = port_cycles();
+    SYST_CSR &= ~SYST_CSR_ENABLE;
+
+    uint32_t completed;
+    uint32_t load;
+    uint32_t elapsed;           // cicluri numarate de SysTick de la repornire
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET) {
+        // am dormit tot intervalul: ultimul tick il numara SysTick_Handler la iesirea din sectiunea critica
+        completed = expected - 1u;
+        uint32_t after_wrap = reload - SYST_CVR;
+        elapsed = reload + after_wrap;
+        load = (after_wrap < SYST_TICK_CYCLES) ? (SYST_TICK_CYCLES - after_wrap) : 2u;
+    } else {
+        // trezit mai devreme de alta intrerupere
+        uint32_t remaining = SYST_CVR;
+        uint32_t left = (remaining + SYST_TICK_CYCLES - 1u) / SYST_TICK_CYCLES;
+        completed = expected - left;
+        elapsed = reload - remaining;
+        load = remaining - (left - 1u) * SYST_TICK_CYCLES;
+    }
+    // SysTick a mers tot intervalul, CYCCNT doar partea treaza din jurul WFI
+    uint32_t awake = stopped_at - started_at;
+    *slept_cycles = (elapsed > awake) ? elapsed - awake : 0u;
+    // scadem si a doua oprire (dupa WFI pana la repornire), masurata la fel
+    stopped = port_cycles() - stopped_at;
+    load = (load > stopped + 2u) ? load - stopped : 2u;
+
+    // restul tick-ului curent, apoi inapoi la perioada normala
+    SYST_RVR = load - 1u;
+    SYST_CVR = 0u;
+    SYST_CSR |= SYST_CSR_ENABLE;
+    SYST_RVR = SYST_TICK_CYCLES - 1u;
+
+    return completed;
+}
+
+// ----------------------------------------------
+// PendSV_Handler pentru context switching
+// ----------------------------------------------
+// apelat la finalul PendSV_Handler, dupa restaurarea contextului noului task
+__attribute__((used)) static void port_cs_exit(void)
+{
+    rtos_cs_record(DWT_CYCCNT - cs_entry_cycles);
+}
+
+__attribute__((naked))
+void PendSV_Handler(void)
+{
+    __asm volatile(
+        "LDR   r3, =0xE0001004        \n"  // DWT_CYCCNT la intrare
+        "LDR   r3, [r3]               \n"
+        "LDR   r1, =cs_entry_cycles   \n"
+        "STR   r3, [r1]               \n"
+
+        "MRS   r0, PSP                \n"
+        "CBZ   r0, 1f                 \n"
+        "STMDB r0!, {r4-r11}          \n"
+        "LDR   r1, =current_task      \n"
+        "LDR   r2, [r1]               \n"
+        "STR   r0, [r2]               \n"  // current_task->stack_ptr = PSP
+        "1:                           \n"
+
+        // listele ready nu trebuie modificate de SysTick / ISR-uri in timpul
+        // alegerii; cele peste RTOS_MAX_SYSCALL_PRIORITY raman active
+        "MOV   r0, #" PORT_STR(RTOS_MAX_SYSCALL_PRIORITY) " \n"
+        "MSR   basepri, r0            \n"
+        "ISB                          \n"
+        "BL    rtos_scheduler_next    \n"
+        // 0 literal: presupune ca PendSV (PENDSV_PRIO minim) nu intra niciodata cu BASEPRI ridicat
+        "MOV   r0, #0                 \n"
+        "MSR   basepri, r0            \n"
+
+        "LDR   r1, =current_task      \n"
+        "LDR   r2, [r1]               \n"
+        "LDR   r0, [r2]               \n"  // r0 = next_task->stack_ptr
+        "LDMIA r0!, {r4-r11}          \n"
+        "MSR   PSP, r0                \n"
+
+        "BL    port_cs_exit           \n"  // r4-r11 sunt callee-saved
+
+        // IMPORTANT: intoarcere in Thread mode folosind PSP
+        "LDR   lr, =0xFFFFFFFD        \n"
+        "BX    lr                     \n"
+    );
+}
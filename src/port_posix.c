@@ -0,0 +1,181 @@
+#define _GNU_SOURCE
+#include "port.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// ----------------------------------------------
+// Port POSIX (simulare pe Linux)
+// ----------------------------------------------
+// Un singur thread de OS; fiecare task are un ucontext_t.
+//  - sectiune critica = flag-ul irq_masked (ca BASEPRI; pe host nu exista
+//    intreruperi "peste" kernel); nu face syscall-uri
+//  - SysTick = SIGALRM periodic; daca vine cu IRQ mascate ramane pending
+//  - PendSV  = switch_pending, servit la iesirea din sectiunea critica
+//  - tickless idle = sare direct la urmatorul eveniment (timp virtual), asa
+//    scenariile in care task-urile doar asteapta ruleaza mult mai repede decat real-time
+
+typedef struct {
+    ucontext_t uc;
+    void (*task_fn)(void);
+} host_ctx_t;
+
+#define CTX(t) ((host_ctx_t *)(t)->stack_ptr)
+
+static volatile sig_atomic_t irq_masked = 1;    // ca la reset pe MCU: pana la start
+static volatile sig_atomic_t tick_pending = 0;
+static volatile sig_atomic_t switch_pending = 0;
+static uint32_t switch_start = 0;
+
+#define barrier() __asm volatile("" : : : "memory")
+
+uint32_t port_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+// echivalentul PendSV_Handler; apelat cu irq_masked = 1
+static void do_switch(void)
+{
+    rtos_tcb_t *prev = current_task;
+
+    switch_start = port_cycles();
+    rtos_scheduler_next();
+
+    if (current_task != prev) {
+        swapcontext(&CTX(prev)->uc, &CTX(current_task)->uc);
+        // aici revine prev, cand e ales din nou
+    }
+    rtos_cs_record(port_cycles() - switch_start);
+}
+
+// serveste "intreruperile" ramase pending; apelat cu irq_masked = 0
+static void service_pending(void)
+{
+    while (tick_pending || switch_pending) {
+        irq_masked = 1;
+        barrier();
+        if (tick_pending) {
+            tick_pending = 0;
+            rtos_tick_handler();        // port_yield() de aici doar marcheaza switch_pending
+        }
+        if (switch_pending) {
+            switch_pending = 0;
+            do_switch();
+        }
+        barrier();
+        irq_masked = 0;
+    }
+}
+
+uint32_t port_enter_critical(void)
+{
+    uint32_t saved = (uint32_t)irq_masked;
+    irq_masked = 1;
+    barrier();
+    return saved;
+}
+
+void port_exit_critical(uint32_t saved)
+{
+    barrier();
+    irq_masked = (sig_atomic_t)saved;
+    barrier();
+    if (!saved && (tick_pending || switch_pending)) service_pending();
+}
+
+void port_yield(void)
+{
+    switch_pending = 1;
+    if (!irq_masked) service_pending();
+}
+
+static void tick_signal(int sig)
+{
+    (void)sig;
+    int saved_errno = errno;
+
+    tick_pending = 1;
+    if (!irq_masked) service_pending();  // poate comuta pe alt task chiar din handler
+
+    errno = saved_errno;
+}
+
+static void task_entry(void)
+{
+    // primul switch catre un task nou vine din do_switch, in sectiune critica
+    port_exit_critical(0);
+    CTX(current_task)->task_fn();
+
+    fprintf(stderr, "port_posix: un task s-a intors din functia sa\n");
+    exit(2);
+}
+
+void port_init(void)
+{
+    irq_masked = 1;
+    tick_pending = 0;
+    switch_pending = 0;
+}
+
+uint32_t *port_init_stack(uint32_t *stack, uint32_t size_words, void (*task_fn)(void))
+{
+    // contextul sta in varful zonei de stiva, stiva efectiva e sub el
+    uintptr_t top = (uintptr_t)(stack + size_words) - sizeof(host_ctx_t);
+    host_ctx_t *ctx = (host_ctx_t *)(top & ~(uintptr_t)63u);
+
+    memset(ctx, 0, sizeof(*ctx));
+    getcontext(&ctx->uc);
+    ctx->uc.uc_stack.ss_sp = stack;
+    ctx->uc.uc_stack.ss_size = (size_t)((uint8_t *)ctx - (uint8_t *)stack);
+    ctx->uc.uc_link = NULL;
+    sigemptyset(&ctx->uc.uc_sigmask);
+    ctx->task_fn = task_fn;
+    makecontext(&ctx->uc, task_entry, 0);
+
+    return (uint32_t *)ctx;
+}
+
+void port_start_scheduler(void)
+{
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = tick_signal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &sa, NULL);
+
+    struct itimerval it;
+    it.it_interval.tv_sec = 0;
+    it.it_interval.tv_usec = 1000000 / RTOS_TICK_RATE_HZ;
+    it.it_value = it.it_interval;
+    setitimer(ITIMER_REAL, &it, NULL);
+
+    // primul task e deja ales de rtos_start(); task_entry reactiveaza IRQ
+    setcontext(&CTX(current_task)->uc);
+
+    fprintf(stderr, "port_posix: setcontext a esuat\n");
+    exit(2);
+}
+
+uint32_t port_tickless_sleep(uint32_t expected_ticks, uint32_t *slept_cycles)
+{
+    // timp virtual: trecem instant peste tick-urile fara evenimente; ultimul
+    // tick e procesat normal la iesirea din sectiunea critica
+    *slept_cycles = 0;
+    tick_pending = 1;
+    return expected_ticks - 1u;
+}
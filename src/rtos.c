@@ -1,186 +1,528 @@
 #include "rtos.h"
+#include "port.h"
+#include "trace.h"
 
-// DWT (Data Watchpoint and Trace) pentru măsurare cicluri
-#define DWT_CTRL     (*(volatile uint32_t *)0xE0001000)
-#define DWT_CYCCNT   (*(volatile uint32_t *)0xE0001004)
-#define DEM_CR       (*(volatile uint32_t *)0xE000EDFC)
-
-#define DEM_CR_TRCENA (1 << 24)
-#define DWT_CTRL_CYCCNTENA (1 << 0)
-
-#define SCB_SHPR3 (*(volatile uint32_t *)0xE000ED20) 
-// Adresa SCB_ICSR (pentru PendSV trigger)
-#define SCB_ICSR  (*(volatile uint32_t *)0xE000ED04)
-#define SCB_ICSR_PENDSVSET (1UL << 28)
 // ----------------------------------------------
 // Pool static de TCB-uri si stive
 // ----------------------------------------------
 static rtos_tcb_t tcb_pool[RTOS_MAX_TASKS];
 static uint32_t tcb_count = 0;
 static uint32_t task_stacks[RTOS_MAX_TASKS][RTOS_STACK_SIZE] __attribute__((aligned(8)));
-static rtos_tcb_t *current_task = NULL;
+rtos_tcb_t *current_task = NULL;     // citit si de context switch-ul din port
 static rtos_tcb_t *ready_lists[RTOS_MAX_PRIORITIES];
-static rtos_tcb_t *delay_list = NULL; // lista sortata dupa wake_tick (simplu, max task-uri mici)
+static rtos_tcb_t *delay_list = NULL; // lista sortata dupa wake_tick: delay-uri + timeout-uri
 static uint32_t top_priority_mask = 0;
+static uint32_t slice_ticks[RTOS_MAX_PRIORITIES];   // cuanta round-robin per nivel
+#if RTOS_EDF
+// min-heap de task-uri EDF READY, cheie = deadline absolut
+static rtos_tcb_t *edf_heap[RTOS_MAX_TASKS];
+static uint32_t edf_count = 0;
+static volatile uint32_t edf_misses_total = 0;
+#define EDF_BIT (1u << RTOS_EDF_PRIORITY)
+// in heap stau doar task-urile EDF aflate pe nivelul lor (nu si cele ridicate prin PI)
+#define EDF_QUEUED(t) ((t)->rel_deadline != 0 && (t)->ready_prio == RTOS_EDF_PRIORITY)
+#endif
 volatile uint32_t g_tick = 0;
 static volatile uint32_t rtos_started=0;
-extern void systick_init(void);
-//Lista de timere și statistici determinism
-static rtos_timer_t *timer_list = NULL;
+static void (*deadline_miss_hook)(rtos_tcb_t *t) = NULL;
+#if RTOS_DEBUG
+static void (*assert_hook)(const char *file, uint32_t line) = NULL;
+#endif
+static rtos_tcb_t *idle_task = NULL;     // marcat de primul apel rtos_idle_sleep()
+//Timer wheel și statistici determinism
+#define TIMER_WHEEL_MASK (RTOS_TIMER_WHEEL_SIZE - 1u)
+static rtos_timer_t *timer_wheel[RTOS_TIMER_WHEEL_SIZE];
+static volatile uint32_t timer_dropped = 0;
+
+#if RTOS_TIMER_TASK
+// coada lock-free SPSC: producator = tick ISR, consumator = timer_task;
+// o intrare tine si generatia timer-ului din momentul expirarii
+#define TIMER_QUEUE_MASK (RTOS_TIMER_QUEUE_SIZE - 1u)
+typedef struct {
+    rtos_timer_t *timer;
+    uint32_t gen;
+} timer_queue_entry_t;
+static timer_queue_entry_t timer_queue[RTOS_TIMER_QUEUE_SIZE];
+static volatile uint32_t timer_queue_head = 0;   // scris doar de ISR
+static volatile uint32_t timer_queue_tail = 0;   // scris doar de timer_task
+static rtos_sem_t timer_task_sem;
+#endif
 
-static volatile uint32_t context_switch_cycles = 0;
-static volatile uint32_t max_context_switch_cycles = 0;
 volatile uint32_t isr_latency_cycles = 0;
 volatile uint32_t max_isr_latency_cycles = 0;
+volatile uint32_t tick_isr_cycles = 0;
+volatile uint32_t max_tick_isr_cycles = 0;
 static volatile uint32_t last_cs_cycles = 0;
 static volatile uint32_t max_cs_cycles = 0;
+static uint32_t min_cs_cycles = 0xFFFFFFFFu;
+static uint64_t sum_cs_cycles = 0;
+static uint32_t count_cs = 0;
+static uint32_t hist_cs[RTOS_CS_HIST_BUCKETS];
+// id pentru trace: index in tcb_pool + 1 (0 = niciun task)
+#define TASK_ID(t) ((t) ? (uint32_t)((t) - tcb_pool) + 1u : 0u)
+#define TRACE(ev, t, obj) TRACE_EVENT((ev), TASK_ID(t), (obj))
+
 // forward declarations
 static void ready_insert(rtos_tcb_t *t);
 static void ready_remove(rtos_tcb_t *t);
+static rtos_tcb_t *ready_pick(void);
 static void task_set_eff_priority(rtos_tcb_t *t, uint32_t new_eff);
+static void mutex_pi_recompute(rtos_mutex_t *m);
+static void wait_list_insert(rtos_wait_list_t *wl, rtos_tcb_t *t);
+static void wait_list_remove(rtos_tcb_t *t);
+static rtos_tcb_t *wait_list_pop(rtos_wait_list_t *wl);
+static void task_wake(rtos_tcb_t *t, rtos_wait_result_t res);
+static void delay_list_insert(rtos_tcb_t *t);
+static void delay_list_remove(rtos_tcb_t *t);
+static void timer_link(rtos_timer_t *timer);
+static void timer_unlink(rtos_timer_t *timer);
+static rtos_tcb_t *sem_give_locked(rtos_sem_t *sem);
+static int task_block_current(rtos_wait_list_t *wl, void *obj, task_state_t state,
+                              uint32_t timeout_ticks, uint32_t irq);
+#if RTOS_TIMER_TASK
+static void timer_queue_push(rtos_timer_t *timer);
+static void timer_task(void);
+#endif
 static uint32_t get_next_task_priority(uint32_t mask);
-static void set_exception_priorities(void);
-static void dwt_init(void);
+static void time_slice_tick(void);
+static rtos_tcb_t *task_create(void (*task_fn)(void), uint32_t priority, uint32_t rel_deadline);
+static void task_delay_current(uint32_t wake_tick, uint32_t irq);
+#if RTOS_EDF
+static void edf_heap_push(rtos_tcb_t *t);
+static void edf_heap_remove(rtos_tcb_t *t);
+static void edf_job_release(rtos_tcb_t *t);
+static void edf_job_end(rtos_tcb_t *t);
+static void edf_check_late(void);
+#endif
+#if RTOS_TICKLESS_IDLE
+static uint32_t idle_expected_ticks(void);
+static void tick_skip(uint32_t ticks);
+#endif
 
 // ----------------------------------------------
 // Functii pentru Tick
 // ----------------------------------------------
+// din SysTick; ISR-urile cu prioritate mai mare care apeleaza kernel-ul il pot
+// preempta, de aceea ruleaza tot in sectiune critica
 void rtos_tick_handler()
 {
+    uint32_t irq = port_enter_critical();
+
     g_tick++;
+    TRACE(TRACE_TICK, current_task, g_tick);
 
-    // 1) wake delayed tasks
+    // 0) tick-ul se contorizeaza task-ului care a rulat; rotire la cuanta expirata
+    time_slice_tick();
+
+    // 1) wake delayed tasks + timeout-uri expirate (doar capul listei, O(expirate))
     while (delay_list && (int32_t)(g_tick - delay_list->wake_tick) >= 0) {
         rtos_tcb_t *t = delay_list;
-        delay_list = delay_list->next;
-
-        t->state = TASK_READY;
-        t->next = NULL;
-        ready_insert(t);
-    }
 
-    // 2) timeouts pentru task-uri blocate (scan pool - max mic, ok)
-    for (uint32_t i = 0; i < tcb_count; i++) {
-        rtos_tcb_t *t = &tcb_pool[i];
-        if ((t->state == TASK_BLOCKED_SEM ||
-             t->state == TASK_BLOCKED_MUTEX ||
-             t->state == TASK_BLOCKED_QUEUE) &&
-             t->wake_tick != 0 &&
-            t->wait_res == RTOS_WAIT_PENDING)
-        {
-            if ((int32_t)(g_tick - t->wake_tick) >= 0) {
-                // timeout expirat
-                t->state = TASK_READY;
-                t->wait_obj = NULL;
-                t->wait_res = RTOS_WAIT_TIMEOUT;
-                t->wake_tick = 0;
-                ready_insert(t);
-            }
+        if (t->state == TASK_DELAYED) {
+            delay_list_remove(t);
+            t->state = TASK_READY;
+#if RTOS_EDF
+            edf_job_release(t);     // cheia din heap trebuie setata inainte de insert
+#endif
+            ready_insert(t);
+            TRACE(TRACE_TASK_READY, t, 0);
+        } else {
+            // blocat pe sem/mutex/queue cu timeout finit
+            task_wake(t, RTOS_WAIT_TIMEOUT);
         }
     }
 
-    // 3) soft timers (lasam, dar vezi nota de ISR minimal)
-    // (optional: lasam callback-urile sa fie super scurte)
-    rtos_timer_t *timer = timer_list;
+#if RTOS_EDF
+    edf_check_late();
+#endif
+
+    // 2) soft timers: doar slot-ul tick-ului curent
+    // (fara RTOS_TIMER_TASK callback-urile ruleaza aici, in ISR -> super scurte)
+    uint32_t slot = g_tick & TIMER_WHEEL_MASK;
+    rtos_timer_t *timer = timer_wheel[slot];
     while (timer != NULL) {
-        if (timer->active) {
-            timer->remaining_ticks--;
-            if (timer->remaining_ticks == 0) {
-                timer->remaining_ticks = timer->period_ticks;
-                if (timer->callback) timer->callback();
+        rtos_timer_t *next = timer->next;
+
+        // in slot stau si timere din ture viitoare ale rotii; comparatie cu semn:
+        // o expirare sarita cumva nu asteapta 2^32 tick-uri, ruleaza la urmatoarea
+        // trecere prin slot
+        if ((int32_t)(g_tick - timer->expiry_tick) >= 0) {
+            TRACE(TRACE_TIMER_EXPIRE, current_task, TRACE_OBJ(timer));
+            timer_unlink(timer);
+            if (timer->mode == RTOS_TIMER_AUTO_RELOAD) {
+                timer->expiry_tick += timer->period_ticks;
+                timer_link(timer);
+            } else {
+                timer->active = 0;
             }
+
+#if RTOS_TIMER_TASK
+            // callback-ul ruleaza in timer_task, in context de thread
+            timer_queue_push(timer);
+#else
+            if (timer->callback) timer->callback();
+
+            // callback-ul poate porni/opri timere din acest slot -> reluam de la cap
+            // (cele re-armate au expirarea in viitor, deci nu se repeta)
+            next = timer_wheel[slot];
+#endif
         }
-        timer = timer->next;
+        timer = next;
     }
 
+#if RTOS_TIMER_TASK
+    if (timer_queue_head != timer_queue_tail) sem_give_locked(&timer_task_sem);
+#endif
+
+    port_exit_critical(irq);
+
     // Declansam PendSV pentru a verifica dacă un task proaspat trezit are prioritate mai mare
-    SCB_ICSR = SCB_ICSR_PENDSVSET;
+    port_yield();
 }
 
 uint32_t rtos_now(){
     return g_tick;
 }
 
+// ----------------------------------------------
+// Tickless idle
+// ----------------------------------------------
+#if RTOS_TICKLESS_IDLE
+// cate tick-uri pot trece fara ca vreun task/timer sa trebuiasca trezit
+static uint32_t idle_expected_ticks(void)
+{
+    uint32_t expected = 0xFFFFFFFFu;
+
+    if (delay_list) {
+        int32_t d = (int32_t)(delay_list->wake_tick - g_tick);
+        if (d <= 0) return 0;
+        expected = (uint32_t)d;
+    }
+
+    // slot-ul (g_tick + d) contine doar timere cu expirare >= d tick-uri,
+    // deci ne putem opri cand d depaseste minimul gasit
+    for (uint32_t d = 1; d <= RTOS_TIMER_WHEEL_SIZE && d < expected; d++) {
+        rtos_timer_t *tm = timer_wheel[(g_tick + d) & TIMER_WHEEL_MASK];
+        for (; tm != NULL; tm = tm->next) {
+            // expirare deja depasita: ruleaza cand ajungem la slot-ul ei, peste d tick-uri
+            uint32_t left = ((int32_t)(tm->expiry_tick - g_tick) > 0) ? tm->expiry_tick - g_tick : d;
+            if (left < expected) expected = left;
+        }
+    }
+    return expected;
+}
+
+// avanseaza timpul cu tick-uri in care garantat nu expira nimic
+// (timerele au expirare absoluta, slot-urile sarite nu contin nimic scadent)
+static void tick_skip(uint32_t ticks)
+{
+    g_tick += ticks;
+}
+#endif
+
+void rtos_idle_sleep(void)
+{
+    idle_task = current_task;
+
+#if RTOS_TICKLESS_IDLE
+    uint32_t irq = port_enter_critical();
+
+    // doar task-ul curent (idle) e READY?
+    uint32_t p = current_task->ready_prio;
+    if (top_priority_mask == (1u << p) && ready_lists[p] == current_task &&
+        current_task->next == current_task)
+    {
+        uint32_t expected = idle_expected_ticks();
+        if (expected >= RTOS_TICKLESS_MIN_IDLE_TICKS) {
+            uint32_t slept_cycles;
+            uint32_t slept = port_tickless_sleep(expected, &slept_cycles);
+            tick_skip(slept);
+#if RTOS_TASK_STATS && PORT_CYCLES_STOP_IN_SLEEP
+            // contorul de cicluri nu a numarat cat a dormit: rularea idle-ului incepe
+            // mai devreme (cu tot cu tick-ul partial al unei treziri premature)
+            current_task->run_start -= slept_cycles;
+#else
+            (void)slept_cycles;
+#endif
+        }
+    }
+
+    port_exit_critical(irq);
+#endif
+}
+
+// ----------------------------------------------
+// Ready lists (circulare, dublu inlantuite prin next/prev)
+// ----------------------------------------------
+// Invariant: in ready_lists[p] sunt DOAR task-uri READY cu ready_prio == p,
+// iar bitul p din top_priority_mask e setat <=> lista nu e goala. Un task READY
+// nu e niciodata in delay_list, deci next/prev pot fi folosite de ambele.
+// ready_prio == eff_priority pentru orice task in afara de cel curent: lock /
+// unlock pe mutex ii schimba doar eff_priority, iar mutarea intre liste o face
+// rtos_scheduler_next(), abia cand chiar se decide cine ruleaza.
+
+// la coada listei (dupa task-urile READY deja existente la aceeasi prioritate)
 static void ready_insert(rtos_tcb_t *t)
 {
     uint32_t p = t->eff_priority;
+    rtos_tcb_t *head = ready_lists[p];
+
+    t->ready_prio = p;
+    t->slice_used = 0;      // cuanta noua la fiecare intrare in READY
+
+#if RTOS_EDF
+    if (EDF_QUEUED(t)) {
+        edf_heap_push(t);
+        top_priority_mask |= EDF_BIT;
+        return;
+    }
+#endif
 
-    if (ready_lists[p] == NULL) {
+    if (head == NULL) {
         t->next = t;
+        t->prev = t;
         ready_lists[p] = t;
         top_priority_mask |= (1u << p);
         return;
     }
 
-    t->next = ready_lists[p]->next;
-    ready_lists[p]->next = t;
+    t->next = head;
+    t->prev = head->prev;
+    head->prev->next = t;
+    head->prev = t;
 }
 
+// O(1); apelat doar pentru task-uri aflate in ready list
 static void ready_remove(rtos_tcb_t *t)
 {
-    uint32_t p = t->eff_priority;
-    rtos_tcb_t *head = ready_lists[p];
-    if (!head) return;
+    uint32_t p = t->ready_prio;
 
-    // lista circulara: cautam predecesorul
-    rtos_tcb_t *prev = head;
-    while (prev->next != t && prev->next != head) {
-        prev = prev->next;
+#if RTOS_EDF
+    if (EDF_QUEUED(t)) {
+        edf_heap_remove(t);
+        if (edf_count == 0 && ready_lists[p] == NULL) top_priority_mask &= ~EDF_BIT;
+        return;
     }
-    if (prev->next != t) return; // nu e in lista
-
-    if (t == head) {
-        if (head->next == head) {
-            ready_lists[p] = NULL;
-            top_priority_mask &= ~(1u << p);
-        } else {
-            ready_lists[p] = head->next;
-            prev->next = head->next;
-        }
+#endif
+
+    if (t->next == t) {
+        ready_lists[p] = NULL;
+#if RTOS_EDF
+        if (p != RTOS_EDF_PRIORITY || edf_count == 0)
+#endif
+        top_priority_mask &= ~(1u << p);
     } else {
-        prev->next = t->next;
+        t->prev->next = t->next;
+        t->next->prev = t->prev;
+        if (ready_lists[p] == t) ready_lists[p] = t->next;
     }
 
     t->next = NULL;
+    t->prev = NULL;
+}
+
+// task-ul curent (READY, pe CPU): ridicarea nu cere niciodata un switch, deci
+// doar o notam; vezi invariantul ready_prio de mai sus
+static void current_set_eff_priority(uint32_t new_eff)
+{
+    if (current_task->eff_priority == new_eff) return;
+    TRACE(TRACE_TASK_PRIORITY, current_task, new_eff);
+    current_task->eff_priority = new_eff;
+}
+
+// dupa o coborare a prioritatii curentului: l-ar inlocui scheduler-ul acum?
+static int current_outranked(void)
+{
+    rtos_tcb_t *t = current_task;
+    // coborat sub nivelul pe care e legat: il mutam acum, altfel bitul lui
+    // ar ascunde task-urile de sub el
+    if (t->eff_priority < t->ready_prio) {
+        ready_remove(t);
+        ready_insert(t);
+    }
+    uint32_t top = get_next_task_priority(top_priority_mask);
+    if (top > t->eff_priority) return 1;
+    return top == t->ready_prio && ready_pick() != t;
 }
- 
+
 static void task_set_eff_priority(rtos_tcb_t *t, uint32_t new_eff)
 {
     if (t->eff_priority == new_eff) return;
+    TRACE(TRACE_TASK_PRIORITY, t, new_eff);
 
     // daca e READY, trebuie mutat intre ready_lists
     if (t->state == TASK_READY) {
         ready_remove(t);
         t->eff_priority = new_eff;
         ready_insert(t);
+    } else if (t->wait_list) {
+        // blocat pe un obiect: repozitionam in wait list ca sa ramana sortata
+        rtos_wait_list_t *wl = t->wait_list;
+        wait_list_remove(t);
+        t->eff_priority = new_eff;
+        wait_list_insert(wl, t);
     } else {
         t->eff_priority = new_eff;
     }
 }
 
-static uint32_t get_next_task_priority(uint32_t mask)
+// ----------------------------------------------
+// Wait lists (per obiect, sortate descrescator dupa eff_priority)
+// ----------------------------------------------
+static void wait_list_insert(rtos_wait_list_t *wl, rtos_tcb_t *t)
 {
-    if(mask==0) return 0;
-    //calcul O(1) pentru gasirea celei mai inalte prioritati cu __buitlin_clz
-    return 31 - __builtin_clz(mask);
+    // FIFO intre task-uri cu aceeasi prioritate: inseram dupa cele egale
+    rtos_tcb_t *prev = NULL;
+    rtos_tcb_t *it = wl->head;
+    while (it && it->eff_priority >= t->eff_priority) {
+        prev = it;
+        it = it->wait_next;
+    }
+
+    t->wait_prev = prev;
+    t->wait_next = it;
+    if (it) it->wait_prev = t;
+    if (prev) prev->wait_next = t;
+    else wl->head = t;
+
+    t->wait_list = wl;
+}
+
+static void wait_list_remove(rtos_tcb_t *t)
+{
+    rtos_wait_list_t *wl = t->wait_list;
+    if (!wl) return;
+
+    if (t->wait_prev) t->wait_prev->wait_next = t->wait_next;
+    else wl->head = t->wait_next;
+    if (t->wait_next) t->wait_next->wait_prev = t->wait_prev;
+
+    t->wait_next = NULL;
+    t->wait_prev = NULL;
+    t->wait_list = NULL;
+}
+
+static rtos_tcb_t *wait_list_pop(rtos_wait_list_t *wl)
+{
+    rtos_tcb_t *t = wl->head;
+    if (t) wait_list_remove(t);
+    return t;
+}
+
+// scoate task-ul din asteptare si il pune inapoi in READY (apelat in sectiune critica)
+static void task_wake(rtos_tcb_t *t, rtos_wait_result_t res)
+{
+    TRACE(res == RTOS_WAIT_TIMEOUT ? TRACE_TASK_TIMEOUT : TRACE_TASK_READY, t,
+          TRACE_OBJ(t->wait_obj));
+    rtos_mutex_t *pi_mutex = (t->state == TASK_BLOCKED_MUTEX) ? t->wait_obj : NULL;
+    wait_list_remove(t);
+    delay_list_remove(t);
+#if RTOS_EDF
+    if (t->state != TASK_BLOCKED_MUTEX) edf_job_release(t);
+#endif
+    t->state = TASK_READY;
+    t->wait_obj = NULL;
+    t->wait_res = res;
+    t->wake_tick = 0;
+    ready_insert(t);
+
+    // a renuntat la mutex (timeout): owner-ul nu mai mosteneste de la el
+    if (pi_mutex) mutex_pi_recompute(pi_mutex);
+}
+
+// t (abia trezit) ar lua CPU-ul task-ului curent? la egalitate in clasa EDF
+// raspundem "da" si lasam scheduler-ul sa compare deadline-urile
+static int task_preempts(const rtos_tcb_t *t)
+{
+    if (t->eff_priority != current_task->eff_priority) {
+        return t->eff_priority > current_task->eff_priority;
+    }
+#if RTOS_EDF
+    if (t->eff_priority == RTOS_EDF_PRIORITY) return 1;
+#endif
+    return 0;
+}
+
+// varianta _from_isr: switch-ul se cere o singura data, din rtos_yield_from_isr();
+// fara pointer (woken NULL) PendSV e cerut direct
+static void isr_report_woken(uint32_t preempt, uint32_t *woken)
+{
+    if (!preempt) return;
+    if (woken) *woken = 1;
+    else port_yield();
+}
+
+// blocheaza task-ul curent pe wl (in sectiune critica; o inchide cu starea irq);
+// wl NULL = fara obiect, trezit direct prin TCB (notificari)
+// intoarce 1 daca a expirat timeout-ul, 0 daca a fost trezit
+static int task_block_current(rtos_wait_list_t *wl, void *obj, task_state_t state,
+                              uint32_t timeout_ticks, uint32_t irq)
+{
+    TRACE(TRACE_TASK_BLOCK, current_task, TRACE_OBJ(obj));
+#if RTOS_EDF
+    if (state != TASK_BLOCKED_MUTEX) edf_job_end(current_task);
+#endif
+    current_task->state = state;
+    current_task->wait_obj = obj;
+    current_task->wait_res = RTOS_WAIT_PENDING;
+
+    // scoate din ready list (ca sa nu mai fie ales) si intra in coada obiectului
+    ready_remove(current_task);
+    if (wl) wait_list_insert(wl, current_task);
+
+    // timeout finit -> in delay_list; 0xFFFFFFFF = infinit (doar in wait list)
+    if (timeout_ticks != 0xFFFFFFFFu) {
+        current_task->wake_tick = g_tick + timeout_ticks;
+        delay_list_insert(current_task);
+    }
+
+    port_exit_critical(irq);
+
+    // lasa scheduler-ul sa ruleze alt task
+    port_yield();
+
+    // cand revine aici, ori a fost semnalat, ori a expirat timeout-ul
+    return current_task->wait_res == RTOS_WAIT_TIMEOUT;
+}
+
+// ----------------------------------------------
+// Delay list (dublu inlantuita, sortata dupa wake_tick)
+// ----------------------------------------------
+static void delay_list_insert(rtos_tcb_t *t)
+{
+    // dupa task-urile cu acelasi wake_tick (FIFO)
+    rtos_tcb_t *prev = NULL;
+    rtos_tcb_t *it = delay_list;
+    while (it && (int32_t)(it->wake_tick - t->wake_tick) <= 0) {
+        prev = it;
+        it = it->next;
+    }
+
+    t->prev = prev;
+    t->next = it;
+    if (it) it->prev = t;
+    if (prev) prev->next = t;
+    else delay_list = t;
 }
 
-static void set_exception_priorities()
+static void delay_list_remove(rtos_tcb_t *t)
 {
-    // Setează PendSV la 255 (cea mai mică) și SysTick la ceva mai mare (ex. 128)
-    SCB_SHPR3 = (0xFF << 16) | (0x80 << 24);
+    // nu e in lista (ex. blocat fara timeout)
+    if (t->prev == NULL && delay_list != t) return;
+
+    if (t->prev) t->prev->next = t->next;
+    else delay_list = t->next;
+    if (t->next) t->next->prev = t->prev;
+
+    t->next = NULL;
+    t->prev = NULL;
 }
 
-// Functie pentru initializare DWT
-static void dwt_init(void) {
-    // Enable trace
-    DEM_CR |= DEM_CR_TRCENA;
-    
-    // Reset counter
-    DWT_CYCCNT = 0;
-    
-    // Enable counter
-    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+static uint32_t get_next_task_priority(uint32_t mask)
+{
+    if(mask==0) return 0;
+    //calcul O(1) pentru gasirea celei mai inalte prioritati cu __buitlin_clz
+    return 31 - __builtin_clz(mask);
 }
 
 // ----------------------------------------------
@@ -191,124 +533,247 @@ void rtos_init(){
     current_task = NULL;
     delay_list = NULL;
     top_priority_mask = 0;
-    for (uint32_t i = 0; i < RTOS_MAX_PRIORITIES; i++) ready_lists[i] = NULL;
-
-    set_exception_priorities();
-    dwt_init();
+    for (uint32_t i = 0; i < RTOS_MAX_PRIORITIES; i++) {
+        ready_lists[i] = NULL;
+        slice_ticks[i] = RTOS_TIME_SLICE_TICKS;
+    }
+#if RTOS_EDF
+    edf_count = 0;
+    edf_misses_total = 0;
+#endif
+    for (uint32_t i = 0; i < RTOS_TIMER_WHEEL_SIZE; i++) timer_wheel[i] = NULL;
+
+    port_init();
+#if RTOS_TRACE
+    trace_init();
+#endif
+
+#if RTOS_TIMER_TASK
+    timer_queue_head = 0;
+    timer_queue_tail = 0;
+    rtos_sem_init(&timer_task_sem, 0);
+    rtos_task_create(timer_task, RTOS_TIMER_TASK_PRIORITY);
+#endif
 }
 
 // ----------------------------------------------
 // selecteaza urmatorul task de rulat
 // ----------------------------------------------
-void rtos_scheduler_next() {
-    if(tcb_count == 0) return;
-
-    uint32_t temp_mask = top_priority_mask;
-    while(temp_mask > 0) {
-        // Găsim cea mai înaltă prioritate din masca temporară
-        uint32_t prio =get_next_task_priority(temp_mask);
-        rtos_tcb_t *start_task = ready_lists[prio];
-        rtos_tcb_t *search = start_task;
-
-        do {
-            // Task-ul este eligibil DOAR daca este in starea READY
-            if (search->state == TASK_READY) {
-                current_task = search;
-                ready_lists[prio] = search;
-                return;
+// cea mai mare prioritate cu task-uri READY, apoi capul listei ei
+static rtos_tcb_t *ready_pick(void)
+{
+    uint32_t p = get_next_task_priority(top_priority_mask);
+    rtos_tcb_t *next = ready_lists[p];
+#if RTOS_EDF
+    // pe nivelul EDF: intai task-urile ridicate aici prin PI (tin un mutex
+    // asteptat de un task EDF), apoi deadline-ul cel mai apropiat
+    if (next == NULL) next = edf_heap[0];
+#endif
+    return next;
 }
 
-            search = search->next;
-        } while (search != start_task);
+void rtos_scheduler_next() {
+    if(tcb_count == 0 || top_priority_mask == 0) return;
+
+#if RTOS_TASK_STATS
+    uint32_t now = port_cycles();
+    rtos_tcb_t *prev = current_task;
+#endif
+
+    // prioritatea curentului schimbata lenes de un mutex: intai in lista potrivita
+    rtos_tcb_t *cur = current_task;
+    if (cur && cur->state == TASK_READY && cur->ready_prio != cur->eff_priority) {
+        ready_remove(cur);
+        ready_insert(cur);
+    }
 
-        // Dacă nu am găsit nimic la prioritatea asta, o eliminăm din mască și căutăm la următoarea
-        temp_mask &= ~(1u << prio);
+    rtos_tcb_t *next = ready_pick();
+    TRACE(TRACE_TASK_SWITCH, next, 0);
+    current_task = next;
+
+#if RTOS_TASK_STATS
+    // apelat din PendSV: contabilizam rularea task-ului care iese de pe CPU
+    if (next != prev) {
+        if (prev) {
+            uint32_t run = now - prev->run_start;
+            prev->run_cycles += run;
+            if (run > prev->max_run) prev->max_run = run;
+            if (prev->state == TASK_READY) prev->preemptions++;
+            else prev->blocks++;
+        }
+        next->switches++;
+        next->run_start = now;
     }
+#endif
+}
+// ----------------------------------------------
+// Masurare cost context switch
+// ----------------------------------------------
+// apelat de port dupa restaurarea contextului noului task
+void rtos_cs_record(uint32_t cycles)
+{
+    last_cs_cycles = cycles;
+    if (cycles > max_cs_cycles) max_cs_cycles = cycles;
+    if (cycles < min_cs_cycles) min_cs_cycles = cycles;
+    sum_cs_cycles += cycles;
+    count_cs++;
+    hist_cs[cycles ? 31 - __builtin_clz(cycles) : 0]++;
 }
+
+#if RTOS_TASK_STATS
 // ----------------------------------------------
-// PendSV_Handler pentru context switching
+// Statistici per task
 // ----------------------------------------------
-__attribute__((naked))
-void PendSV_Handler(void)
+uint32_t rtos_get_task_stats(rtos_task_stats_t *out, uint32_t max, uint64_t *total_cycles)
 {
-    __asm volatile(
-        "MRS   r0, PSP                \n"
-        "CBZ   r0, 1f                 \n"
-        "STMDB r0!, {r4-r11}          \n"
-        "LDR   r1, =current_task      \n"
-        "LDR   r2, [r1]               \n"
-        "STR   r0, [r2]               \n"  // current_task->stack_ptr = PSP
-        "1:                           \n"
+    uint64_t total = 0;
+    uint32_t n = 0;
 
-        "PUSH  {lr}                   \n"
-        "BL    rtos_scheduler_next    \n"
-        "POP   {lr}                   \n"
+    uint32_t irq = port_enter_critical();
+    uint32_t now = port_cycles();
 
-        "LDR   r1, =current_task      \n"
-        "LDR   r2, [r1]               \n"
-        "LDR   r0, [r2]               \n"  // r0 = next_task->stack_ptr
-        "LDMIA r0!, {r4-r11}          \n"
-        "MSR   PSP, r0                \n"
+    for (uint32_t i = 0; i < tcb_count; i++) {
+        rtos_tcb_t *t = &tcb_pool[i];
+        uint64_t cycles = t->run_cycles;
+        uint32_t max_run = t->max_run;
+
+        // rularea in curs a task-ului care a apelat (singurul pe CPU acum)
+        if (t == current_task) {
+            uint32_t run = now - t->run_start;
+            cycles += run;
+            if (run > max_run) max_run = run;
+        }
+        total += cycles;
+
+        if (n < max) {
+            rtos_task_stats_t *s = &out[n++];
+            s->name = t->name;
+            s->id = i + 1u;
+            s->base_priority = t->base_priority;
+            s->eff_priority = t->eff_priority;
+            s->state = t->state;
+            s->is_idle = (t == idle_task);
+            s->cycles = cycles;
+            s->switches = t->switches;
+            s->preemptions = t->preemptions;
+            s->blocks = t->blocks;
+            s->max_run = max_run;
+        }
+    }
+
+    port_exit_critical(irq);
 
-        // IMPORTANT: intoarcere in Thread mode folosind PSP
-        "LDR   lr, =0xFFFFFFFD        \n"
-        "BX    lr                     \n"
-    );
+    if (total_cycles) *total_cycles = total;
+    return n;
 }
 
+// incepe o fereastra noua de masurare (ex. sarcina CPU pe ultimele N secunde)
+void rtos_reset_task_stats(void)
+{
+    uint32_t irq = port_enter_critical();
+    for (uint32_t i = 0; i < tcb_count; i++) {
+        rtos_tcb_t *t = &tcb_pool[i];
+        t->run_cycles = 0;
+        t->max_run = 0;
+        t->switches = 0;
+        t->preemptions = 0;
+        t->blocks = 0;
+    }
+    if (current_task) current_task->run_start = port_cycles();
+    port_exit_critical(irq);
+}
+#endif
 
 // ----------------------------------------------
 // Creare task
 // ----------------------------------------------
-void rtos_task_create(void (*task_fn)(void), uint32_t priority){
+rtos_tcb_t *rtos_task_create(void (*task_fn)(void), uint32_t priority){
+#if RTOS_EDF
+    // un task cu prioritate fixa pe nivelul EDF ar trece mereu inaintea heap-ului
+    // (rtos_scheduler_next alege intai ready_lists[RTOS_EDF_PRIORITY])
+    if (priority == RTOS_EDF_PRIORITY) return NULL;
+#endif
+    return task_create(task_fn, priority, 0);
+}
+
+#if RTOS_EDF
+rtos_tcb_t *rtos_task_create_edf(void (*task_fn)(void), uint32_t rel_deadline_ticks)
+{
+    if (rel_deadline_ticks == 0) return NULL;
+    return task_create(task_fn, RTOS_EDF_PRIORITY, rel_deadline_ticks);
+}
+#endif
+
+static rtos_tcb_t *task_create(void (*task_fn)(void), uint32_t priority, uint32_t rel_deadline)
+{
     if(tcb_count >= RTOS_MAX_TASKS){
-        return;
+        return NULL;
     }
 
     rtos_tcb_t *tcb = &tcb_pool[tcb_count];
     tcb->base_priority = priority;
     tcb->eff_priority  = priority;
+    tcb->ready_prio    = priority;
     tcb->state = TASK_READY;
     tcb->wait_obj = NULL;
     tcb->wait_res = RTOS_WAIT_OK;
+    tcb->notify_value = 0;
+    tcb->notify_pending = 0;
+    tcb->event_bits = 0;
+    tcb->event_opts = 0;
     tcb->wake_tick = 0;
-
-    uint32_t *stack = task_stacks[tcb_count];
-    uint32_t size = RTOS_STACK_SIZE;
-
-    stack[size - 1] = 0x01000000;           // xPSR (thumb bit = 1)
-    stack[size - 2] = (uint32_t)task_fn | 0x01;  // PC = functia task-ului
-    stack[size - 3] = 0xFFFFFFFD;           // LR pentru thread mode cu PSP (stiva separata)
-    stack[size - 4] = 0;                    // R12
-    stack[size - 5] = 0;                    // R3
-    stack[size - 6] = 0;                    // R2
-    stack[size - 7] = 0;                    // R1
-    stack[size - 8] = 0;                    // R0
-
-    // context software (R4..R11) va fi salvat/restaurat ulterior
-    tcb->stack_ptr = &stack[size - 16];
+    tcb->wait_list = NULL;
+    tcb->held_mutexes = NULL;
+    tcb->held_pending = NULL;
+    tcb->wait_next = NULL;
+    tcb->wait_prev = NULL;
+    tcb->period = 0;
+    tcb->period_deadline = 0;
+    tcb->release = 0;
+    tcb->jobs = 0;
+    tcb->period_misses = 0;
+    tcb->overruns = 0;
+    tcb->worst_response = 0;
+    tcb->worst_jitter = 0;
+#if RTOS_TASK_STATS
+    tcb->name = NULL;
+    tcb->run_cycles = 0;
+    tcb->run_start = 0;
+    tcb->max_run = 0;
+    tcb->switches = 0;
+    tcb->preemptions = 0;
+    tcb->blocks = 0;
+#endif
+#if RTOS_EDF
+    tcb->rel_deadline = rel_deadline;
+    tcb->deadline_misses = 0;
+    edf_job_release(tcb);
+#else
+    (void)rel_deadline;
+#endif
+
+    // cadrul initial de stiva depinde de CPU
+    tcb->stack_ptr = port_init_stack(task_stacks[tcb_count], RTOS_STACK_SIZE, task_fn);
 
     ready_insert(tcb);
+    TRACE(TRACE_TASK_CREATE, tcb, priority);
 
     tcb_count++;
+    return tcb;
 }
 // ----------------------------------------------
 // Pornire scheduler
 // ----------------------------------------------
 void rtos_start(){
     rtos_scheduler_next(); // Alege primul task
-    
-    __asm volatile("mov r0, #0 \n msr psp, r0"); // Spune-i lui PendSV că e prima rulare
-    
-    set_exception_priorities();
-    systick_init();
-    
-    __asm volatile("cpsie i" : : : "memory"); 
+    rtos_started = 1;
 
-    SCB_ICSR = SCB_ICSR_PENDSVSET;
-    while (1) { /* nimic */ }
-    //for(;;) { __asm volatile("wfi"); }
+    port_start_scheduler();
+}
 
+uint32_t rtos_is_running(void)
+{
+    return rtos_started;
 }
 
 // ----------------------------------------------
@@ -316,223 +781,690 @@ void rtos_start(){
 // ----------------------------------------------
 void rtos_yield() 
 {
-    SCB_ICSR = SCB_ICSR_PENDSVSET; //declansare PendSV
-}
-void rtos_delay(uint32_t ticks)
-{
-    if (ticks == 0) return;
-
-    __asm volatile("cpsid i" : : : "memory");
-
-    current_task->state = TASK_DELAYED;
-    current_task->wake_tick = g_tick + ticks;
-
-    // scoate din READY
-    ready_remove(current_task);
+    uint32_t irq = port_enter_critical();
 
-    // insereaza sortat in delay_list (lista simpla)
-    rtos_tcb_t **pp = &delay_list;
-    while (*pp && (int32_t)((*pp)->wake_tick - current_task->wake_tick) <= 0) {
-        pp = &(*pp)->next;
+    // trecem la coada listei: urmatorul task READY de aceeasi prioritate ruleaza primul
+    if (current_task && current_task->state == TASK_READY) {
+        uint32_t p = current_task->ready_prio;
+        if (ready_lists[p] == current_task) ready_lists[p] = current_task->next;
+        current_task->slice_used = 0;
     }
-    current_task->next = *pp;
-    *pp = current_task;
 
-    __asm volatile("cpsie i" : : : "memory");
+    port_exit_critical(irq);
+    port_yield(); //declansare PendSV
+}
 
-    rtos_yield();
+// la sfarsitul unui ISR: un singur PendSV, care ruleaza la iesirea din intrerupere
+void rtos_yield_from_isr(uint32_t woken)
+{
+    if (woken) port_yield();
 }
 
+#if RTOS_EDF
 // ----------------------------------------------
-// Semafor binar
+// EDF: heap binar dupa deadline absolut
 // ----------------------------------------------
-void rtos_sem_init(rtos_sem_t *sem, uint32_t initial_count) {
-    sem->count = initial_count; //0 sau 1 pt sem binar
+// comparatie cu semn: corecta cat timp deadline-urile sunt la < 2^31 tick-uri distanta
+static int edf_before(const rtos_tcb_t *a, const rtos_tcb_t *b)
+{
+    return (int32_t)(a->deadline - b->deadline) < 0;
 }
-void rtos_sem_wait(rtos_sem_t *sem)
+
+static void edf_heap_set(uint32_t i, rtos_tcb_t *t)
 {
-    (void)rtos_sem_wait_timeout(sem, 0xFFFFFFFFu);
+    edf_heap[i] = t;
+    t->heap_idx = i;
 }
 
+static void edf_sift_up(uint32_t i)
+{
+    rtos_tcb_t *t = edf_heap[i];
+    while (i > 0) {
+        uint32_t parent = (i - 1u) / 2u;
+        if (!edf_before(t, edf_heap[parent])) break;
+        edf_heap_set(i, edf_heap[parent]);
+        i = parent;
+    }
+    edf_heap_set(i, t);
+}
 
-int rtos_sem_wait_timeout(rtos_sem_t *sem, uint32_t timeout_ticks)
+static void edf_sift_down(uint32_t i)
 {
+    rtos_tcb_t *t = edf_heap[i];
     while (1) {
-        __asm volatile("cpsid i" : : : "memory");
-
-        // 1) semafor disponibil -> il luam si iesim
-        if (sem->count > 0) {
-            sem->count--;
-            current_task->wait_res = RTOS_WAIT_OK;      // <-- CORECT
-            current_task->wake_tick = 0;
-            current_task->wait_obj = NULL;
-            __asm volatile("cpsie i" : : : "memory");
-            return 0;
-        }
+        uint32_t child = 2u * i + 1u;
+        if (child >= edf_count) break;
+        if (child + 1u < edf_count && edf_before(edf_heap[child + 1u], edf_heap[child])) child++;
+        if (!edf_before(edf_heap[child], t)) break;
+        edf_heap_set(i, edf_heap[child]);
+        i = child;
+    }
+    edf_heap_set(i, t);
+}
 
-        // 2) timeout imediat
-        if (timeout_ticks == 0) {
-            current_task->wait_res = RTOS_WAIT_TIMEOUT;
-            __asm volatile("cpsie i" : : : "memory");
-            return 1;
-        }
+static void edf_heap_push(rtos_tcb_t *t)
+{
+    t->next = NULL;
+    t->prev = NULL;
+    edf_heap_set(edf_count, t);
+    edf_count++;
+    edf_sift_up(t->heap_idx);
+}
 
-        // 3) blocam task-ul pe semafor
-        current_task->state = TASK_BLOCKED_SEM;
-        current_task->wait_obj = (void*)sem;
-        current_task->wait_res = RTOS_WAIT_PENDING;    // <-- CORECT
+// O(log n): ultimul element ia locul lui t si coboara sau urca
+static void edf_heap_remove(rtos_tcb_t *t)
+{
+    uint32_t i = t->heap_idx;
+    rtos_tcb_t *last = edf_heap[--edf_count];
 
-        // set timeout: wake_tick=0 inseamna "infinit"
-        if (timeout_ticks != 0xFFFFFFFFu) {
-            current_task->wake_tick = g_tick + timeout_ticks;
+    if (last != t) {
+        edf_heap_set(i, last);
+        if (i > 0 && edf_before(last, edf_heap[(i - 1u) / 2u])) {
+            edf_sift_up(i);
         } else {
-            current_task->wake_tick = 0;
+            edf_sift_down(i);
         }
+    }
+}
 
-        // scoate din ready list (ca sa nu mai fie ales)
-        ready_remove(current_task);
-
-        __asm volatile("cpsie i" : : : "memory");
-
-        // lasa scheduler-ul sa ruleze alt task
-        rtos_yield();
+static void edf_job_release(rtos_tcb_t *t)
+{
+    if (t->rel_deadline == 0) return;
+    t->deadline = g_tick + t->rel_deadline;
+    t->job_late = 0;
+}
 
-        // 4) cand revine aici, ori a fost semnalat, ori a expirat timeout-ul
-        if (current_task->wait_res == RTOS_WAIT_TIMEOUT) {
-            return 1;
-        }
+// job-ul s-a terminat (task-ul asteapta urmatoarea eliberare)
+static void edf_job_end(rtos_tcb_t *t)
+{
+    if (t->rel_deadline == 0 || t->job_late) return;
+    if ((int32_t)(g_tick - t->deadline) > 0) {
+        t->job_late = 1;
+        t->deadline_misses++;
+        edf_misses_total++;
+    }
+}
 
-        // daca a fost deblocat (OK), reluam bucla si incercam sa luam semaforul atomic
-        // (asta evita race-condition: signal intre wake si decrement)
+// din tick: daca deadline-ul cel mai apropiat a trecut, miss-ul e numarat acum,
+// nu abia la terminarea job-ului (restul heap-ului are deadline-uri mai tarzii)
+static void edf_check_late(void)
+{
+    if (edf_count == 0) return;
+    rtos_tcb_t *t = edf_heap[0];
+    if (!t->job_late && (int32_t)(g_tick - t->deadline) > 0) {
+        t->job_late = 1;
+        t->deadline_misses++;
+        edf_misses_total++;
     }
 }
 
+uint32_t rtos_task_deadline_misses(const rtos_tcb_t *t)
+{
+    return t->deadline_misses;
+}
 
-void rtos_sem_signal(rtos_sem_t *sem)
+uint32_t rtos_get_deadline_misses(void)
 {
-    __asm volatile("cpsid i" : : : "memory");
+    return edf_misses_total;
+}
+#endif
 
-    sem->count++;
+// ----------------------------------------------
+// Round-robin (time slicing)
+// ----------------------------------------------
+// apelat din tick ISR; task-ul curent e capul listei sale (il alege scheduler-ul)
+static void time_slice_tick(void)
+{
+    rtos_tcb_t *t = current_task;
+    if (t == NULL || t->state != TASK_READY) return;   // tocmai s-a blocat, PendSV in asteptare
 
-    // trezim un singur task care asteapta semaforul
-    for (uint32_t i = 0; i < tcb_count; i++) {
-        if (tcb_pool[i].state == TASK_BLOCKED_SEM && tcb_pool[i].wait_obj == sem) {
-            tcb_pool[i].state = TASK_READY;
-            tcb_pool[i].wait_obj = NULL;
-            tcb_pool[i].wait_res = RTOS_WAIT_OK;
-            tcb_pool[i].wake_tick = 0;
-            ready_insert(&tcb_pool[i]);
-            break;
-        }
+    uint32_t p = t->ready_prio;
+    t->slice_used++;
+    if (slice_ticks[p] == 0 || t->slice_used < slice_ticks[p]) return;
+
+    t->slice_used = 0;
+    if (ready_lists[p] == t && t->next != t) {
+        ready_lists[p] = t->next;       // t ajunge la coada; port_yield() din tick face switch-ul
     }
+}
 
-    __asm volatile("cpsie i" : : : "memory");
-    rtos_yield(); // verificam daca task-ul deblocat are prioritate mai mare
+void rtos_set_time_slice(uint32_t priority, uint32_t ticks)
+{
+    if (priority >= RTOS_MAX_PRIORITIES) return;
+    slice_ticks[priority] = ticks;
 }
 
-// ----------------------------------------------
-// Mutex cu Priority Inheritance
-// ----------------------------------------------
-void rtos_mutex_init(rtos_mutex_t *mutex) {
-    if (mutex == NULL) return;
+uint32_t rtos_task_slice_used(const rtos_tcb_t *t)
+{
+    return t->slice_used;
+}
 
-    mutex->lock = 0;                // Mutex-ul este liber inițial
-    mutex->owner = NULL;            // Nu aparține niciunui task
-    mutex->original_priority = 0;   // Valoare neutră
+rtos_tcb_t *rtos_task_current(void)
+{
+    return current_task;
 }
 
-void rtos_mutex_lock(rtos_mutex_t *mutex)
+void rtos_task_set_name(rtos_tcb_t *t, const char *name)
 {
-    (void)rtos_mutex_lock_timeout(mutex, 0xFFFFFFFFu);
+#if RTOS_TASK_STATS
+    if (t) t->name = name;
+#else
+    (void)t; (void)name;
+#endif
 }
 
-int rtos_mutex_lock_timeout(rtos_mutex_t *mutex, uint32_t timeout_ticks)
+void rtos_delay(uint32_t ticks)
 {
-    while (1) {
-        __asm volatile("cpsid i" : : : "memory");
+    if (ticks == 0) return;
 
-        if (mutex->lock == 0) {
-            mutex->lock = 1;
-            mutex->owner = current_task;
-            mutex->original_priority = current_task->base_priority; // baza, nu eff
-            current_task->wait_res = RTOS_WAIT_OK;
-            __asm volatile("cpsie i" : : : "memory");
-            return 0;
-        }
+    uint32_t irq = port_enter_critical();
+    task_delay_current(g_tick + ticks, irq);
+}
 
-        // PI: daca eu sunt mai sus, ridic owner-ul EFECTIV
-        if (mutex->owner && current_task->eff_priority > mutex->owner->eff_priority) {
-            task_set_eff_priority(mutex->owner, current_task->eff_priority);
-        }
+// in sectiune critica (o inchide cu starea irq); wake_tick trebuie sa fie in viitor
+static void task_delay_current(uint32_t wake_tick, uint32_t irq)
+{
+    TRACE(TRACE_TASK_DELAY, current_task, wake_tick - g_tick);
+#if RTOS_EDF
+    edf_job_end(current_task);
+#endif
+    current_task->state = TASK_DELAYED;
+    current_task->wake_tick = wake_tick;
 
-        // blocam pe mutex
-        current_task->state = TASK_BLOCKED_MUTEX;
-        current_task->wait_obj = mutex;
-        current_task->wait_res = RTOS_WAIT_PENDING;
+    // scoate din READY
+    ready_remove(current_task);
 
-        if (timeout_ticks == 0) {
-            current_task->state = TASK_READY;
-            current_task->wait_obj = NULL;
-            current_task->wait_res = RTOS_WAIT_TIMEOUT;
-            __asm volatile("cpsie i" : : : "memory");
-            return 1;
-        } else if (timeout_ticks != 0xFFFFFFFFu) {
-            current_task->wake_tick = g_tick + timeout_ticks;
-        } else {
-            current_task->wake_tick = 0;
-        }
+    // insereaza sortat in delay_list
+    delay_list_insert(current_task);
 
-        ready_remove(current_task);
+    port_exit_critical(irq);
 
-        __asm volatile("cpsie i" : : : "memory");
-        rtos_yield();
+    port_yield();
+}
 
-        if (current_task->wait_res == RTOS_WAIT_TIMEOUT) return 1;
+// ----------------------------------------------
+// Task-uri periodice
+// ----------------------------------------------
+rtos_tcb_t *rtos_task_create_periodic(void (*task_fn)(void), uint32_t priority,
+                                      uint32_t period, uint32_t offset, uint32_t deadline)
+{
+    if (period == 0) return NULL;
+    if (deadline == 0) deadline = period;
+
+    // ca rtos_task_create(): apelat inainte de rtos_start(), fara sectiune critica
+#if RTOS_EDF
+    rtos_tcb_t *t = task_create(task_fn, priority, (priority == RTOS_EDF_PRIORITY) ? deadline : 0);
+#else
+    rtos_tcb_t *t = task_create(task_fn, priority, 0);
+#endif
+    if (t == NULL) return NULL;
+
+    t->period = period;
+    t->period_deadline = deadline;
+    t->release = g_tick + offset;
+
+    // prima eliberare in viitor: task-ul porneste direct din delay_list
+    if (offset != 0) {
+        ready_remove(t);
+        t->state = TASK_DELAYED;
+        t->wake_tick = t->release;
+        delay_list_insert(t);
     }
+
+    return t;
 }
 
-void rtos_mutex_unlock(rtos_mutex_t *mutex)
+// sfarsitul job-ului curent; asteapta eliberarea urmatoare pe grila
+// release_k = release_0 + k * period (fara drift, comparatii cu semn)
+int rtos_wait_next_period(void)
 {
-    __asm volatile("cpsid i" : : : "memory");
+    uint32_t irq = port_enter_critical();
 
-    if (mutex->owner != current_task) {
-        __asm volatile("cpsie i" : : : "memory");
-        return;
+    rtos_tcb_t *t = current_task;
+    if (t->period == 0) {
+        port_exit_critical(irq);
+        return 0;
     }
 
-    // restore owner eff prio la base
-    task_set_eff_priority(current_task, current_task->base_priority);
+    uint32_t now = g_tick;
+    uint32_t response = now - t->release;
+    int missed = (int32_t)(response - t->period_deadline) > 0;
+
+    t->jobs++;
+    if (response > t->worst_response) t->worst_response = response;
+    if (missed) t->period_misses++;
+
+    // job terminat dupa eliberarea urmatoare: pornim imediat, dar eliberarile
+    // complet ratate sunt sarite, ca sa nu se adune o rafala de job-uri
+    uint32_t next = t->release + t->period;
+    if ((int32_t)(now - next) >= 0) {
+        t->overruns++;
+        while ((int32_t)(now - (next + t->period)) >= 0) {
+            next += t->period;
+            t->overruns++;
+        }
+    }
+    t->release = next;
 
-    mutex->lock = 0;
-    mutex->owner = NULL;
+    port_exit_critical(irq);
 
-    // trezim primul waiter
-    for (uint32_t i = 0; i < tcb_count; i++) {
-        rtos_tcb_t *t = &tcb_pool[i];
-        if (t->state == TASK_BLOCKED_MUTEX && t->wait_obj == mutex) {
-            t->state = TASK_READY;
-            t->wait_obj = NULL;
-            t->wait_res = RTOS_WAIT_OK;
-            t->wake_tick = 0;
-            ready_insert(t);
-            break;
+    if (missed && deadline_miss_hook) deadline_miss_hook(t);
+
+    int preempted = 0;
+    irq = port_enter_critical();
+    if ((int32_t)(t->release - g_tick) > 0) {
+        task_delay_current(t->release, irq);   // trezit exact la release (inchide sectiunea critica)
+        irq = port_enter_critical();
+    }
+#if RTOS_EDF
+    else if (t->rel_deadline) {
+        // fara delay nu trece prin edf_job_release(): deadline-ul job-ului intarziat.
+        // Task-ul e inca READY in heap, deci cheia nu se schimba pe loc
+        if (EDF_QUEUED(t)) edf_heap_remove(t);
+        t->deadline = t->release + t->rel_deadline;
+        t->job_late = 0;
+        if (EDF_QUEUED(t)) {
+            edf_heap_push(t);
+            preempted = (edf_heap[0] != t);
         }
     }
+#endif
+
+    // intarzierea pornirii job-ului fata de eliberare
+    uint32_t jitter = g_tick - t->release;
+    if (jitter > t->worst_jitter) t->worst_jitter = jitter;
+
+    port_exit_critical(irq);
+
+    if (preempted) port_yield();   // un alt task EDF are acum deadline-ul mai apropiat
+    return missed;
+}
+
+int rtos_task_get_periodic_stats(const rtos_tcb_t *t, rtos_periodic_stats_t *out)
+{
+    if (t == NULL || out == NULL || t->period == 0) return 1;
+
+    uint32_t irq = port_enter_critical();
+    out->period = t->period;
+    out->deadline = t->period_deadline;
+    out->jobs = t->jobs;
+    out->misses = t->period_misses;
+    out->overruns = t->overruns;
+    out->worst_response = t->worst_response;
+    out->worst_jitter = t->worst_jitter;
+    port_exit_critical(irq);
+    return 0;
+}
+
+void rtos_set_deadline_miss_hook(void (*hook)(rtos_tcb_t *t))
+{
+    deadline_miss_hook = hook;
+}
+
+#if RTOS_DEBUG
+void rtos_set_assert_hook(void (*hook)(const char *file, uint32_t line))
+{
+    assert_hook = hook;
+}
 
-    __asm volatile("cpsie i" : : : "memory");
-    rtos_yield();
+// fara hook: ramane aici cu kernel-ul oprit, locatia se vede in debugger
+void rtos_assert_failed(const char *file, uint32_t line)
+{
+    (void)port_enter_critical();
+    if (assert_hook) assert_hook(file, line);
+    while (1) {}
+}
+#endif
+
+// ----------------------------------------------
+// Semafor binar
+// ----------------------------------------------
+void rtos_sem_init(rtos_sem_t *sem, uint32_t initial_count) {
+    sem->count = initial_count; //0 sau 1 pt sem binar
+    sem->waiters.head = NULL;
+}
+void rtos_sem_wait(rtos_sem_t *sem)
+{
+    (void)rtos_sem_wait_timeout(sem, 0xFFFFFFFFu);
+}
+
+
+int rtos_sem_wait_timeout(rtos_sem_t *sem, uint32_t timeout_ticks)
+{
+    // calea rapida: count > 0 se decrementeaza cu port_cas(), fara sectiune critica
+    uint32_t c = sem->count;
+    while (c > 0) {
+        if (port_cas(&sem->count, c, c - 1u)) {
+            TRACE(TRACE_SEM_TAKE, current_task, TRACE_OBJ(sem));
+            current_task->wait_res = RTOS_WAIT_OK;
+            return 0;
+        }
+        c = sem->count;
+    }
+
+    while (1) {
+        uint32_t irq = port_enter_critical();
+
+        // 1) semafor disponibil -> il luam si iesim
+        if (sem->count > 0) {
+            sem->count--;
+            TRACE(TRACE_SEM_TAKE, current_task, TRACE_OBJ(sem));
+            current_task->wait_res = RTOS_WAIT_OK;      // <-- CORECT
+            current_task->wake_tick = 0;
+            current_task->wait_obj = NULL;
+            port_exit_critical(irq);
+            return 0;
+        }
+
+        // 2) timeout imediat
+        if (timeout_ticks == 0) {
+            current_task->wait_res = RTOS_WAIT_TIMEOUT;
+            port_exit_critical(irq);
+            return 1;
+        }
+
+        // 3) blocam task-ul pe semafor
+        // 4) cand revine, ori a fost semnalat, ori a expirat timeout-ul
+        if (task_block_current(&sem->waiters, (void*)sem, TASK_BLOCKED_SEM, timeout_ticks, irq)) {
+            return 1;
+        }
+
+        // daca a fost deblocat (OK), reluam bucla si incercam sa luam semaforul atomic
+        // (asta evita race-condition: signal intre wake si decrement)
+    }
+}
+
+
+// apelat in sectiune critica (sau din tick handler); intoarce task-ul trezit
+static rtos_tcb_t *sem_give_locked(rtos_sem_t *sem)
+{
+    sem->count++;
+    TRACE(TRACE_SEM_GIVE, current_task, TRACE_OBJ(sem));
+
+    // trezim waiter-ul cu cea mai mare prioritate (capul listei, O(1))
+    rtos_tcb_t *t = wait_list_pop(&sem->waiters);
+    if (t) task_wake(t, RTOS_WAIT_OK);
+    return t;
+}
+
+void rtos_sem_signal(rtos_sem_t *sem)
+{
+    uint32_t irq = port_enter_critical();
+
+    rtos_tcb_t *t = sem_give_locked(sem);
+
+    port_exit_critical(irq);
+    if (t) port_yield(); // verificam daca task-ul deblocat are prioritate mai mare
+}
+
+void rtos_sem_signal_from_isr(rtos_sem_t *sem, uint32_t *woken)
+{
+    uint32_t irq = port_enter_critical();
+    rtos_tcb_t *t = sem_give_locked(sem);
+    isr_report_woken(t && task_preempts(t), woken);
+    port_exit_critical(irq);
+}
+
+// ----------------------------------------------
+// Mutex cu Priority Inheritance
+// ----------------------------------------------
+// PI tranzitiv: eff_priority a unui task = max(base, capul wait list-ului
+// fiecarui mutex detinut). Cand un task blocat pe mutex e ridicat, owner-ul
+// mutex-ului e ridicat si el, si tot asa pe lantul owner -> blocat pe -> owner.
+// Lantul e parcurs de cel mult RTOS_MAX_TASKS ori (un deadlock e un ciclu).
+// Un mutex IPCP contribuie si cu plafonul; cat timp toti cei care il folosesc
+// au baza <= plafon, waiter-ii lui nu pot depasi owner-ul si lantul se opreste
+// imediat.
+//
+// Cuvantul lock tine owner-ul (MUTEX_ID) si bitul MUTEX_WAITERS. Bitul e pus in
+// sectiune critica inainte de blocare si sters doar de calea lenta, deci cat e
+// 0 nu exista waiter-i: lock 0 -> id si id -> 0 merg cu un port_cas(), fara
+// kernel. Pe un mutex PI fara waiter-i prioritatea owner-ului nu depinde de el,
+// asa ca nici nu trebuie recalculata. IPCP schimba prioritatea la fiecare lock,
+// deci trece mereu prin kernel.
+#define MUTEX_WAITERS   1u
+#define MUTEX_ID(t)     (((uint32_t)((t) - tcb_pool) + 1u) << 1)
+
+static rtos_tcb_t *mutex_owner(const rtos_mutex_t *m)
+{
+    uint32_t id = m->lock >> 1;
+    return id ? &tcb_pool[id - 1u] : NULL;
+}
+
+rtos_tcb_t *rtos_mutex_owner(const rtos_mutex_t *mutex)
+{
+    return mutex_owner(mutex);
+}
+
+// scoate m din lista celor detinute de t (de obicei e primul: LIFO); pe calea
+// rapida de unlock poate lipsi deja
+static void held_unlink(rtos_tcb_t *t, rtos_mutex_t *m)
+{
+    rtos_mutex_t *volatile *pp = &t->held_mutexes;
+    while (*pp && *pp != m) pp = &(*pp)->held_next;
+    if (*pp) *pp = m->held_next;
+}
+
+void rtos_mutex_init(rtos_mutex_t *mutex) {
+    if (mutex == NULL) return;
+
+    mutex->lock = 0;                // Mutex-ul este liber inițial
+    mutex->ceiling = 0;             // PI
+    mutex->held_next = NULL;
+    mutex->waiters.head = NULL;
+}
+
+int rtos_mutex_init_ceiling(rtos_mutex_t *mutex, uint32_t ceiling)
+{
+    if (mutex == NULL || ceiling >= RTOS_MAX_PRIORITIES) return 1;
+
+    rtos_mutex_init(mutex);
+    mutex->ceiling = ceiling;
+    return 0;
+}
+
+// prioritatea la care m isi tine owner-ul: plafonul (IPCP) sau cel mai urgent waiter
+static uint32_t mutex_priority(const rtos_mutex_t *m)
+{
+    uint32_t p = m->ceiling;
+    rtos_tcb_t *w = m->waiters.head;            // wait list sortata: capul e maximul
+    if (w && w->eff_priority > p) p = w->eff_priority;
+    return p;
+}
+
+// prioritatea pe care t o are dreptul s-o ruleze din mutex-urile detinute;
+// held_pending acopera fereastra in care calea rapida a luat deja mutex-ul,
+// dar inca nu l-a legat in lista (sau l-a scos, dar inca nu l-a eliberat)
+static uint32_t mutex_inherited_priority(const rtos_tcb_t *t)
+{
+    uint32_t p = t->base_priority;
+    for (rtos_mutex_t *m = t->held_mutexes; m; m = m->held_next) {
+        uint32_t mp = mutex_priority(m);
+        if (mp > p) p = mp;
+    }
+    rtos_mutex_t *m = t->held_pending;
+    if (m && mutex_owner(m) == t) {
+        uint32_t mp = mutex_priority(m);
+        if (mp > p) p = mp;
+    }
+    return p;
+}
+
+// ridica owner-ul lui m (si pe cei de mai departe pe lant) la cel putin prio
+static void mutex_pi_raise(rtos_mutex_t *m, uint32_t prio)
+{
+    for (uint32_t depth = 0; m && depth < RTOS_MAX_TASKS; depth++) {
+        rtos_tcb_t *owner = mutex_owner(m);
+        if (owner == NULL || owner->eff_priority >= prio) return;
+
+        task_set_eff_priority(owner, prio);
+        if (owner->state != TASK_BLOCKED_MUTEX) return;
+        m = owner->wait_obj;
+    }
+}
+
+// waiter-ii lui m s-au schimbat: owner-ul isi recalculeaza prioritatea,
+// iar daca e la randul lui blocat pe un mutex, schimbarea merge mai departe
+static void mutex_pi_recompute(rtos_mutex_t *m)
+{
+    for (uint32_t depth = 0; m && depth < RTOS_MAX_TASKS; depth++) {
+        rtos_tcb_t *owner = mutex_owner(m);
+        if (owner == NULL) return;
+
+        uint32_t p = mutex_inherited_priority(owner);
+        if (p == owner->eff_priority) return;
+
+        task_set_eff_priority(owner, p);
+        if (owner->state != TASK_BLOCKED_MUTEX) return;
+        m = owner->wait_obj;
+    }
+}
+
+void rtos_mutex_lock(rtos_mutex_t *mutex)
+{
+    (void)rtos_mutex_lock_timeout(mutex, 0xFFFFFFFFu);
+}
+
+int rtos_mutex_lock_timeout(rtos_mutex_t *mutex, uint32_t timeout_ticks)
+{
+    // IPCP: un task peste plafon ar putea fi blocat de unul mai putin urgent
+    RTOS_ASSERT(current_task->base_priority <= mutex->ceiling || mutex->ceiling == 0);
+
+    // calea rapida: liber si fara waiter-i
+    if (mutex->ceiling == 0) {
+        current_task->held_pending = mutex;
+        if (port_cas(&mutex->lock, 0, MUTEX_ID(current_task))) {
+            mutex->held_next = current_task->held_mutexes;
+            current_task->held_mutexes = mutex;
+            current_task->held_pending = NULL;
+            TRACE(TRACE_MUTEX_LOCK, current_task, TRACE_OBJ(mutex));
+            current_task->wait_res = RTOS_WAIT_OK;
+            return 0;
+        }
+        current_task->held_pending = NULL;
+    }
+
+    while (1) {
+        uint32_t irq = port_enter_critical();
+
+        if (mutex_owner(mutex) == NULL) {
+            // bitul de waiter-i poate fi ramas de la timeout-uri: il refacem
+            mutex->lock = MUTEX_ID(current_task) | (mutex->waiters.head ? MUTEX_WAITERS : 0u);
+            mutex->held_next = current_task->held_mutexes;
+            current_task->held_mutexes = mutex;
+            // IPCP: direct la plafon; PI: waiter-ii ramasi de la owner-ul
+            // anterior (unlock trezeste doar unul). Doar notat: task-ul e mutat
+            // in lista plafonului abia daca ar fi preemptat
+            uint32_t p = mutex_priority(mutex);
+            if (p > current_task->eff_priority) current_set_eff_priority(p);
+            TRACE(TRACE_MUTEX_LOCK, current_task, TRACE_OBJ(mutex));
+            current_task->wait_res = RTOS_WAIT_OK;
+            port_exit_critical(irq);
+            return 0;
+        }
+
+        // try-lock: nu asteptam, deci nici nu ridicam pe nimeni
+        if (timeout_ticks == 0) {
+            current_task->wait_res = RTOS_WAIT_TIMEOUT;
+            port_exit_critical(irq);
+            return 1;
+        }
+
+        // PI: daca eu sunt mai sus, ridic owner-ul EFECTIV (si lantul din spatele lui)
+        mutex_pi_raise(mutex, current_task->eff_priority);
+
+        // blocam pe mutex; de acum unlock-ul owner-ului trece prin kernel
+        mutex->lock |= MUTEX_WAITERS;
+        if (task_block_current(&mutex->waiters, mutex, TASK_BLOCKED_MUTEX, timeout_ticks, irq)) return 1;
+    }
+}
+
+void rtos_mutex_unlock(rtos_mutex_t *mutex)
+{
+    uint32_t me = MUTEX_ID(current_task);
+
+    // calea rapida: PI fara waiter-i si owner neridicat (altfel prioritatea se
+    // recalculeaza in kernel); scos din lista inainte de eliberare, altfel
+    // urmatorul owner i-ar rescrie held_next cat e inca legat la noi
+    if (mutex->lock == me && mutex->ceiling == 0 &&
+        current_task->eff_priority == current_task->base_priority) {
+        current_task->held_pending = mutex;
+        held_unlink(current_task, mutex);
+        if (port_cas(&mutex->lock, me, 0)) {
+            current_task->held_pending = NULL;
+            TRACE(TRACE_MUTEX_UNLOCK, current_task, TRACE_OBJ(mutex));
+            return;
+        }
+        // a aparut un waiter intre timp: continuam pe calea lenta
+    }
+
+    uint32_t irq = port_enter_critical();
+
+    if (mutex_owner(mutex) != current_task) {
+        port_exit_critical(irq);
+        return;
+    }
+
+    TRACE(TRACE_MUTEX_UNLOCK, current_task, TRACE_OBJ(mutex));
+
+    held_unlink(current_task, mutex);
+    current_task->held_pending = NULL;
+    mutex->held_next = NULL;
+
+    // trezim waiter-ul cu cea mai mare prioritate; ceilalti raman marcati in lock
+    rtos_tcb_t *t = wait_list_pop(&mutex->waiters);
+    mutex->lock = mutex->waiters.head ? MUTEX_WAITERS : 0u;
+    if (t) task_wake(t, RTOS_WAIT_OK);
+
+    // ramanem la prioritatea mostenita din mutex-urile inca detinute; PendSV
+    // doar daca acum altcineva trece inaintea noastra (fara waiter-i si fara
+    // preemptare pe durata plafonului nu se schimba nimic)
+    current_set_eff_priority(mutex_inherited_priority(current_task));
+    int preempt = current_outranked();
+
+    port_exit_critical(irq);
+    if (preempt) port_yield();
 }
 
 // ----------------------------------------------
 // Message Queue
 // ----------------------------------------------
+// Buffer circular protejat de sectiuni critice scurte (ca mailbox-ul), fara
+// mutex: send/receive nu blocheaza decat pe coada plina / goala, iar
+// variantele _from_isr nu blocheaza niciodata.
 void rtos_queue_init(rtos_queue_t *q) {
     q->head = 0;
     q->tail = 0;
-    rtos_sem_init(&q->sem_free_slots, 8);
-    rtos_sem_init(&q->sem_available_msgs, 0);
-    rtos_mutex_init(&q->lock);
+    q->count = 0;
+    q->tx_waiters.head = NULL;
+    q->rx_waiters.head = NULL;
+}
+
+// in sectiune critica; intorc task-ul trezit de pe partea opusa (sau NULL)
+static rtos_tcb_t *queue_put_locked(rtos_queue_t *q, uint32_t msg)
+{
+    TRACE(TRACE_QUEUE_SEND, current_task, TRACE_OBJ(q));
+    q->buffer[q->head] = msg;
+    q->head = (q->head + 1) % RTOS_QUEUE_LENGTH;
+    q->count++;
+
+    rtos_tcb_t *t = wait_list_pop(&q->rx_waiters);
+    if (t) task_wake(t, RTOS_WAIT_OK);
+    return t;
+}
+
+static rtos_tcb_t *queue_get_locked(rtos_queue_t *q, uint32_t *out)
+{
+    TRACE(TRACE_QUEUE_RECEIVE, current_task, TRACE_OBJ(q));
+    *out = q->buffer[q->tail];
+    q->tail = (q->tail + 1) % RTOS_QUEUE_LENGTH;
+    q->count--;
+
+    rtos_tcb_t *t = wait_list_pop(&q->tx_waiters);
+    if (t) task_wake(t, RTOS_WAIT_OK);
+    return t;
 }
+
 void rtos_queue_send(rtos_queue_t *q, uint32_t msg)
 {
     (void)rtos_queue_send_timeout(q, msg, 0xFFFFFFFFu);
@@ -541,15 +1473,38 @@ void rtos_queue_send(rtos_queue_t *q, uint32_t msg)
 
 int rtos_queue_send_timeout(rtos_queue_t *q, uint32_t msg, uint32_t timeout_ticks)
 {
-    if (rtos_sem_wait_timeout(&q->sem_free_slots, timeout_ticks) != 0) return 1;
+    while (1) {
+        uint32_t irq = port_enter_critical();
 
-    rtos_mutex_lock(&q->lock);
-    q->buffer[q->head] = msg;
-    q->head = (q->head + 1) % 8;
-    rtos_mutex_unlock(&q->lock);
+        if (q->count < RTOS_QUEUE_LENGTH) {
+            rtos_tcb_t *t = queue_put_locked(q, msg);
+            port_exit_critical(irq);
+            if (t) port_yield();
+            return 0;
+        }
 
-    rtos_sem_signal(&q->sem_available_msgs);
-    return 0;
+        if (timeout_ticks == 0) {
+            port_exit_critical(irq);
+            return 1;
+        }
+
+        if (task_block_current(&q->tx_waiters, q, TASK_BLOCKED_QUEUE, timeout_ticks, irq)) {
+            return 1;
+        }
+    }
+}
+
+int rtos_queue_send_from_isr(rtos_queue_t *q, uint32_t msg, uint32_t *woken)
+{
+    int ret = 1;
+    uint32_t irq = port_enter_critical();
+    if (q->count < RTOS_QUEUE_LENGTH) {
+        rtos_tcb_t *t = queue_put_locked(q, msg);
+        isr_report_woken(t && task_preempts(t), woken);
+        ret = 0;
+    }
+    port_exit_critical(irq);
+    return ret;
 }
 
 uint32_t rtos_queue_receive(rtos_queue_t *q)
@@ -561,14 +1516,519 @@ uint32_t rtos_queue_receive(rtos_queue_t *q)
 
 int rtos_queue_receive_timeout(rtos_queue_t *q, uint32_t *out, uint32_t timeout_ticks)
 {
-    if (rtos_sem_wait_timeout(&q->sem_available_msgs, timeout_ticks) != 0) return 1;
+    while (1) {
+        uint32_t irq = port_enter_critical();
 
-    rtos_mutex_lock(&q->lock);
-    *out = q->buffer[q->tail];
-    q->tail = (q->tail + 1) % 8;
-    rtos_mutex_unlock(&q->lock);
+        if (q->count > 0) {
+            rtos_tcb_t *t = queue_get_locked(q, out);
+            port_exit_critical(irq);
+            if (t) port_yield();
+            return 0;
+        }
+
+        if (timeout_ticks == 0) {
+            port_exit_critical(irq);
+            return 1;
+        }
 
-    rtos_sem_signal(&q->sem_free_slots);
+        if (task_block_current(&q->rx_waiters, q, TASK_BLOCKED_QUEUE, timeout_ticks, irq)) {
+            return 1;
+        }
+    }
+}
+
+int rtos_queue_receive_from_isr(rtos_queue_t *q, uint32_t *out, uint32_t *woken)
+{
+    int ret = 1;
+    uint32_t irq = port_enter_critical();
+    if (q->count > 0) {
+        rtos_tcb_t *t = queue_get_locked(q, out);
+        isr_report_woken(t && task_preempts(t), woken);
+        ret = 0;
+    }
+    port_exit_critical(irq);
+    return ret;
+}
+
+// ----------------------------------------------
+// SPSC Queue
+// ----------------------------------------------
+static void copy_item(uint8_t *dst, const uint8_t *src, uint32_t n)
+{
+    // cale rapida pe cuvinte pentru item-uri aliniate (cazul uzual: sample-uri)
+    if ((((uint32_t)(uintptr_t)dst | (uint32_t)(uintptr_t)src | n) & 3u) == 0) {
+        uint32_t *d = (uint32_t *)dst;
+        const uint32_t *s = (const uint32_t *)src;
+        for (n >>= 2; n > 0; n--) *d++ = *s++;
+        return;
+    }
+    while (n--) *dst++ = *src++;
+}
+
+// trezeste partea opusa doar daca chiar asteapta cineva
+static void spsc_wake(rtos_wait_list_t *wl)
+{
+    uint32_t irq = port_enter_critical();
+    rtos_tcb_t *t = wait_list_pop(wl);
+    if (t) task_wake(t, RTOS_WAIT_OK);
+    port_exit_critical(irq);
+
+    if (t) port_yield();
+}
+
+int rtos_spsc_init(rtos_spsc_queue_t *q, void *buffer, uint32_t item_size, uint32_t depth)
+{
+    if (q == NULL || buffer == NULL || item_size == 0) return 1;
+    if (depth == 0 || (depth & (depth - 1u)) != 0) return 1;
+
+    q->buffer = (uint8_t *)buffer;
+    q->item_size = item_size;
+    q->mask = depth - 1u;
+    q->head = 0;
+    q->tail = 0;
+    q->rx_waiters.head = NULL;
+    q->tx_waiters.head = NULL;
+    return 0;
+}
+
+uint32_t rtos_spsc_count(const rtos_spsc_queue_t *q)
+{
+    return q->head - q->tail;
+}
+
+int rtos_spsc_send(rtos_spsc_queue_t *q, const void *item, uint32_t timeout_ticks)
+{
+    while (1) {
+        uint32_t head = q->head;
+
+        if (head - q->tail <= q->mask) {
+            copy_item(q->buffer + (head & q->mask) * q->item_size, (const uint8_t *)item,
+                      q->item_size);
+            // item-ul trebuie sa fie vizibil inainte de noul head
+            port_memory_barrier();
+            q->head = head + 1u;
+            TRACE(TRACE_QUEUE_SEND, current_task, TRACE_OBJ(q));
+
+            // head-ul publicat inainte de a citi waiter-ii: consumatorul re-verifica
+            // head in sectiune critica inainte sa se blocheze
+            port_memory_barrier();
+            if (q->rx_waiters.head) spsc_wake(&q->rx_waiters);
+            return 0;
+        }
+
+        if (timeout_ticks == 0) return 1;
+
+        // plina: re-verificam in sectiune critica, consumatorul poate fi eliberat un loc
+        uint32_t irq = port_enter_critical();
+        if (q->head - q->tail <= q->mask) {
+            port_exit_critical(irq);
+            continue;
+        }
+        if (task_block_current(&q->tx_waiters, q, TASK_BLOCKED_QUEUE, timeout_ticks, irq)) return 1;
+    }
+}
+
+int rtos_spsc_receive(rtos_spsc_queue_t *q, void *out, uint32_t timeout_ticks)
+{
+    while (1) {
+        uint32_t tail = q->tail;
+
+        if (q->head != tail) {
+            // citim item-ul abia dupa ce am vazut head-ul publicat
+            port_memory_barrier();
+            copy_item((uint8_t *)out, q->buffer + (tail & q->mask) * q->item_size,
+                      q->item_size);
+            port_memory_barrier();
+            q->tail = tail + 1u;
+            TRACE(TRACE_QUEUE_RECEIVE, current_task, TRACE_OBJ(q));
+
+            port_memory_barrier();
+            if (q->tx_waiters.head) spsc_wake(&q->tx_waiters);
+            return 0;
+        }
+
+        if (timeout_ticks == 0) return 1;
+
+        uint32_t irq = port_enter_critical();
+        if (q->head != q->tail) {
+            port_exit_critical(irq);
+            continue;
+        }
+        if (task_block_current(&q->rx_waiters, q, TASK_BLOCKED_QUEUE, timeout_ticks, irq)) return 1;
+    }
+}
+
+// ----------------------------------------------
+// Memory Pool
+// ----------------------------------------------
+#define BLOCK_HDR(ptr)     ((rtos_block_t *)((uint8_t *)(ptr) - RTOS_POOL_HDR))
+#define BLOCK_PAYLOAD(blk) ((void *)((uint8_t *)(blk) + RTOS_POOL_HDR))
+
+int rtos_pool_init(rtos_pool_t *pool, void *storage, uint32_t block_size, uint32_t block_count)
+{
+    if (pool == NULL || storage == NULL || block_size == 0 || block_count == 0) return 1;
+    if (((uint32_t)(uintptr_t)storage & 7u) != 0) return 1;
+
+    pool->stride = RTOS_POOL_STRIDE(block_size);
+    pool->block_size = block_size;
+    pool->start = (uint8_t *)storage;
+    pool->end = pool->start + pool->stride * block_count;
+    pool->waiters.head = NULL;
+
+    // lista libera intrusiva, in ordinea adreselor
+    pool->free_list = NULL;
+    for (uint32_t i = block_count; i > 0; i--) {
+        rtos_block_t *blk = (rtos_block_t *)(pool->start + (i - 1u) * pool->stride);
+        blk->next = pool->free_list;
+        pool->free_list = blk;
+    }
+    pool->free_count = block_count;
+    return 0;
+}
+
+void *rtos_pool_alloc(rtos_pool_t *pool, uint32_t timeout_ticks)
+{
+    while (1) {
+        uint32_t irq = port_enter_critical();
+
+        rtos_block_t *blk = pool->free_list;
+        if (blk) {
+            pool->free_list = blk->next;
+            pool->free_count--;
+            port_exit_critical(irq);
+            return BLOCK_PAYLOAD(blk);
+        }
+
+        if (timeout_ticks == 0) {
+            port_exit_critical(irq);
+            return NULL;
+        }
+
+        if (task_block_current(&pool->waiters, pool, TASK_BLOCKED_POOL, timeout_ticks, irq)) {
+            return NULL;
+        }
+    }
+}
+
+int rtos_pool_free(rtos_pool_t *pool, void *block)
+{
+    uint8_t *p = (uint8_t *)block;
+    if (p < pool->start + RTOS_POOL_HDR || p >= pool->end) return 1;
+    if ((uint32_t)(p - RTOS_POOL_HDR - pool->start) % pool->stride != 0) return 1;
+
+    uint32_t irq = port_enter_critical();
+
+    rtos_block_t *blk = BLOCK_HDR(block);
+    blk->next = pool->free_list;
+    pool->free_list = blk;
+    pool->free_count++;
+
+    rtos_tcb_t *t = wait_list_pop(&pool->waiters);
+    if (t) task_wake(t, RTOS_WAIT_OK);
+
+    port_exit_critical(irq);
+
+    if (t) port_yield();
+    return 0;
+}
+
+uint32_t rtos_pool_free_count(const rtos_pool_t *pool)
+{
+    return pool->free_count;
+}
+
+// ----------------------------------------------
+// Mailbox
+// ----------------------------------------------
+void rtos_mbox_init(rtos_mbox_t *mbox)
+{
+    mbox->head = NULL;
+    mbox->tail = NULL;
+    mbox->count = 0;
+    mbox->waiters.head = NULL;
+}
+
+// nu blocheaza niciodata: legatura sta in header-ul blocului
+void rtos_mbox_post(rtos_mbox_t *mbox, void *msg)
+{
+    rtos_block_t *blk = BLOCK_HDR(msg);
+    blk->next = NULL;
+
+    uint32_t irq = port_enter_critical();
+
+    if (mbox->tail) mbox->tail->next = blk;
+    else mbox->head = blk;
+    mbox->tail = blk;
+    mbox->count++;
+
+    rtos_tcb_t *t = wait_list_pop(&mbox->waiters);
+    if (t) task_wake(t, RTOS_WAIT_OK);
+
+    port_exit_critical(irq);
+
+    if (t) port_yield();
+}
+
+void *rtos_mbox_fetch(rtos_mbox_t *mbox, uint32_t timeout_ticks)
+{
+    while (1) {
+        uint32_t irq = port_enter_critical();
+
+        rtos_block_t *blk = mbox->head;
+        if (blk) {
+            mbox->head = blk->next;
+            if (mbox->head == NULL) mbox->tail = NULL;
+            mbox->count--;
+            port_exit_critical(irq);
+            return BLOCK_PAYLOAD(blk);
+        }
+
+        if (timeout_ticks == 0) {
+            port_exit_critical(irq);
+            return NULL;
+        }
+
+        if (task_block_current(&mbox->waiters, mbox, TASK_BLOCKED_MBOX, timeout_ticks, irq)) {
+            return NULL;
+        }
+    }
+}
+
+// ----------------------------------------------
+// Notificari directe catre task
+// ----------------------------------------------
+// Starea sta in TCB-ul destinatarului: nicio wait list, niciun obiect
+// partajat; cel mult un task (proprietarul) asteapta pe ea.
+// in sectiune critica; *woken = 1 daca destinatarul trezit preempteaza task-ul curent
+static int notify_locked(rtos_tcb_t *t, uint32_t arg, rtos_notify_action_t action,
+                         uint32_t *woken)
+{
+    int ret = 0;
+
+    switch (action) {
+    case RTOS_NOTIFY_SET_BITS:  t->notify_value |= arg; break;
+    case RTOS_NOTIFY_INCREMENT: t->notify_value++; break;
+    case RTOS_NOTIFY_OVERWRITE: t->notify_value = arg; break;
+    case RTOS_NOTIFY_NO_OVERWRITE:
+        if (t->notify_pending) ret = 1;
+        else t->notify_value = arg;
+        break;
+    default: break;
+    }
+    t->notify_pending = 1;
+
+    if (t->state == TASK_BLOCKED_NOTIFY) {
+        task_wake(t, RTOS_WAIT_OK);
+        if (task_preempts(t)) *woken = 1;
+    }
+    return ret;
+}
+
+int rtos_notify(rtos_tcb_t *t, uint32_t arg, rtos_notify_action_t action)
+{
+    uint32_t woken = 0;
+
+    uint32_t irq = port_enter_critical();
+    int ret = notify_locked(t, arg, action, &woken);
+    port_exit_critical(irq);
+
+    if (woken) port_yield();
+    return ret;
+}
+
+void rtos_notify_give(rtos_tcb_t *t)
+{
+    (void)rtos_notify(t, 0, RTOS_NOTIFY_INCREMENT);
+}
+
+int rtos_notify_from_isr(rtos_tcb_t *t, uint32_t arg, rtos_notify_action_t action,
+                         uint32_t *woken)
+{
+    uint32_t w = 0;
+
+    uint32_t irq = port_enter_critical();
+    int ret = notify_locked(t, arg, action, &w);
+    isr_report_woken(w, woken);
+    port_exit_critical(irq);
+    return ret;
+}
+
+void rtos_notify_give_from_isr(rtos_tcb_t *t, uint32_t *woken)
+{
+    (void)rtos_notify_from_isr(t, 0, RTOS_NOTIFY_INCREMENT, woken);
+}
+
+// folosirea ca semafor numarator: clear = 1 consuma tot (binar), 0 decrementeaza
+uint32_t rtos_notify_take(uint32_t clear, uint32_t timeout_ticks)
+{
+    rtos_tcb_t *self = current_task;
+
+    uint32_t irq = port_enter_critical();
+    uint32_t start = g_tick;
+
+    // o notificare care lasa valoarea 0 (NONE, SET_BITS cu 0) ne trezeste, dar
+    // nu e un "give": ne blocam din nou pentru timpul ramas, ca 0 sa insemne
+    // doar timeout
+    while (self->notify_value == 0 && timeout_ticks != 0) {
+        uint32_t left = timeout_ticks;
+        if (timeout_ticks != 0xFFFFFFFFu) {
+            uint32_t elapsed = g_tick - start;
+            if (elapsed >= timeout_ticks) break;
+            left = timeout_ticks - elapsed;
+        }
+        int timed_out = task_block_current(NULL, NULL, TASK_BLOCKED_NOTIFY, left, irq);
+        irq = port_enter_critical();
+        if (timed_out) break;       // o notificare sosita intre timp e verificata mai jos
+    }
+
+    // doar ce s-a numarat e consumat; o notificare NONE ramane pending pentru notify_wait
+    uint32_t val = self->notify_value;
+    if (val != 0) {
+        self->notify_value = clear ? 0 : val - 1;
+        self->notify_pending = 0;
+    }
+    port_exit_critical(irq);
+
+    return val;
+}
+
+int rtos_notify_wait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                     uint32_t *out_value, uint32_t timeout_ticks)
+{
+    rtos_tcb_t *self = current_task;
+
+    uint32_t irq = port_enter_critical();
+    if (!self->notify_pending) {
+        self->notify_value &= ~clear_on_entry;
+        if (timeout_ticks != 0) {
+            (void)task_block_current(NULL, NULL, TASK_BLOCKED_NOTIFY, timeout_ticks, irq);
+            irq = port_enter_critical();
+        }
+    }
+
+    // o notificare sosita intre timeout si aici e tot o notificare
+    int ret = self->notify_pending ? 0 : 1;
+    if (out_value) *out_value = self->notify_value;
+    if (ret == 0) {
+        self->notify_value &= ~clear_on_exit;
+        self->notify_pending = 0;
+    }
+    port_exit_critical(irq);
+
+    return ret;
+}
+
+// ----------------------------------------------
+// Event Group
+// ----------------------------------------------
+// Waiter-ul nu reincearca dupa trezire: rtos_event_set() decide pentru el si
+// ii lasa in event_bits valoarea care l-a satisfacut.
+void rtos_event_init(rtos_event_group_t *eg)
+{
+    eg->bits = 0;
+    eg->waiters.head = NULL;
+}
+
+static int event_match(uint32_t val, uint32_t bits, uint32_t opts)
+{
+    if (opts & RTOS_EVENT_WAIT_ALL) return (val & bits) == bits;
+    return (val & bits) != 0;
+}
+
+// o singura trecere prin waiters, toti evaluati pe aceeasi valoare; bitii
+// ceruti cu RTOS_EVENT_CLEAR se sterg abia dupa trecere, deci un set poate
+// trezi mai multi waiter-i care asteapta acelasi bit.
+// In sectiune critica; *woken = 1 daca vreun task trezit preempteaza task-ul curent
+static uint32_t event_set_locked(rtos_event_group_t *eg, uint32_t bits, uint32_t *woken)
+{
+    uint32_t clear = 0;
+    uint32_t val = eg->bits | bits;
+    TRACE(TRACE_EVGROUP_SET, current_task, TRACE_OBJ(eg));
+
+    rtos_tcb_t *t = eg->waiters.head;
+    while (t) {
+        rtos_tcb_t *next = t->wait_next;
+        if (event_match(val, t->event_bits, t->event_opts)) {
+            if (t->event_opts & RTOS_EVENT_CLEAR) clear |= t->event_bits;
+            t->event_bits = val;
+            task_wake(t, RTOS_WAIT_OK);
+            if (task_preempts(t)) *woken = 1;
+        }
+        t = next;
+    }
+
+    val &= ~clear;
+    eg->bits = val;
+    return val;
+}
+
+uint32_t rtos_event_set(rtos_event_group_t *eg, uint32_t bits)
+{
+    uint32_t woken = 0;
+
+    uint32_t irq = port_enter_critical();
+    uint32_t val = event_set_locked(eg, bits, &woken);
+    port_exit_critical(irq);
+
+    if (woken) port_yield();
+    return val;
+}
+
+uint32_t rtos_event_set_from_isr(rtos_event_group_t *eg, uint32_t bits, uint32_t *woken)
+{
+    uint32_t w = 0;
+
+    uint32_t irq = port_enter_critical();
+    uint32_t val = event_set_locked(eg, bits, &w);
+    isr_report_woken(w, woken);
+    port_exit_critical(irq);
+    return val;
+}
+
+uint32_t rtos_event_clear(rtos_event_group_t *eg, uint32_t bits)
+{
+    uint32_t irq = port_enter_critical();
+    uint32_t val = eg->bits;
+    eg->bits = val & ~bits;
+    port_exit_critical(irq);
+    return val;
+}
+
+uint32_t rtos_event_get(const rtos_event_group_t *eg)
+{
+    return eg->bits;
+}
+
+int rtos_event_wait(rtos_event_group_t *eg, uint32_t bits, uint32_t opts,
+                    uint32_t *out_bits, uint32_t timeout_ticks)
+{
+    if (bits == 0) return 1;
+
+    uint32_t irq = port_enter_critical();
+
+    uint32_t val = eg->bits;
+    if (event_match(val, bits, opts)) {
+        if (opts & RTOS_EVENT_CLEAR) eg->bits = val & ~bits;
+        TRACE(TRACE_EVGROUP_WAIT, current_task, TRACE_OBJ(eg));
+        port_exit_critical(irq);
+        if (out_bits) *out_bits = val;
+        return 0;
+    }
+
+    if (timeout_ticks == 0) {
+        port_exit_critical(irq);
+        if (out_bits) *out_bits = val;
+        return 1;
+    }
+
+    current_task->event_bits = bits;
+    current_task->event_opts = opts;
+    if (task_block_current(&eg->waiters, eg, TASK_BLOCKED_EVENT, timeout_ticks, irq)) {
+        if (out_bits) *out_bits = eg->bits;
+        return 1;
+    }
+
+    if (out_bits) *out_bits = current_task->event_bits;
     return 0;
 }
 
@@ -581,38 +2041,121 @@ static uint32_t ms_to_ticks(uint32_t ms)
 }
 
 void rtos_timer_init(rtos_timer_t *timer, uint32_t period_ms, void (*callback)(void))
+{
+    rtos_timer_init_mode(timer, period_ms, callback, RTOS_TIMER_AUTO_RELOAD);
+}
+
+void rtos_timer_init_mode(rtos_timer_t *timer, uint32_t period_ms, void (*callback)(void),
+                          rtos_timer_mode_t mode)
 {
     timer->period_ticks = ms_to_ticks(period_ms);
-    timer->remaining_ticks = timer->period_ticks;
+    if (timer->period_ticks == 0) timer->period_ticks = 1;
+    timer->expiry_tick = 0;
     timer->callback = callback;
     timer->active = 0;
+    timer->mode = (uint8_t)mode;
     timer->next = NULL;
+    timer->prev = NULL;
+#if RTOS_TIMER_TASK
+    timer->gen = 0;
+#endif
 }
 
+// insereaza in slot-ul lui expiry_tick (O(1), apelat in sectiune critica)
+static void timer_link(rtos_timer_t *timer)
+{
+    rtos_timer_t **head = &timer_wheel[timer->expiry_tick & TIMER_WHEEL_MASK];
 
-void rtos_timer_start(rtos_timer_t *timer) {
-    __asm volatile("cpsid i" : : : "memory");
-    
+    timer->prev = NULL;
+    timer->next = *head;
+    if (*head) (*head)->prev = timer;
+    *head = timer;
     timer->active = 1;
-    timer->remaining_ticks = timer->period_ticks;
-    
-    if (timer_list == NULL) {
-        timer_list = timer;
-        timer->next = NULL;
-    } else {
-        timer->next = timer_list;
-        timer_list = timer;
-    }
-    
-    __asm volatile("cpsie i" : : : "memory");
 }
 
-void rtos_timer_stop(rtos_timer_t *timer) {
-    __asm volatile("cpsid i" : : : "memory");
+static void timer_unlink(rtos_timer_t *timer)
+{
+    if (!timer->active) return;
+
+    if (timer->prev) timer->prev->next = timer->next;
+    else timer_wheel[timer->expiry_tick & TIMER_WHEEL_MASK] = timer->next;
+    if (timer->next) timer->next->prev = timer->prev;
+
+    timer->next = NULL;
+    timer->prev = NULL;
     timer->active = 0;
-    __asm volatile("cpsie i" : : : "memory");
 }
 
+void rtos_timer_start(rtos_timer_t *timer) {
+    uint32_t irq = port_enter_critical();
+
+    // restart: il scoatem intai, ca sa nu fie legat de doua ori
+    timer_unlink(timer);
+#if RTOS_TIMER_TASK
+    timer->gen++;           // expirarile de dinainte de restart nu mai ruleaza
+#endif
+    timer->expiry_tick = g_tick + timer->period_ticks;
+    timer_link(timer);
+
+    port_exit_critical(irq);
+}
+
+// si cu RTOS_TIMER_TASK: dupa stop callback-ul nu mai porneste (expirarile deja
+// puse in coada sunt aruncate de daemon)
+void rtos_timer_stop(rtos_timer_t *timer) {
+    uint32_t irq = port_enter_critical();
+    timer_unlink(timer);
+#if RTOS_TIMER_TASK
+    timer->gen++;
+#endif
+    port_exit_critical(irq);
+}
+
+uint32_t rtos_timer_get_dropped(void) {
+    return timer_dropped;
+}
+
+#if RTOS_TIMER_TASK
+// ----------------------------------------------
+// Timer service task
+// ----------------------------------------------
+// apelat doar din tick ISR (singurul producator)
+static void timer_queue_push(rtos_timer_t *timer)
+{
+    uint32_t head = timer_queue_head;
+    if (head - timer_queue_tail >= RTOS_TIMER_QUEUE_SIZE) {
+        timer_dropped++;    // daemon-ul nu tine pasul
+        return;
+    }
+    timer_queue[head & TIMER_QUEUE_MASK].timer = timer;
+    timer_queue[head & TIMER_QUEUE_MASK].gen = timer->gen;
+    port_memory_barrier();
+    timer_queue_head = head + 1u;   // publicam intrarea dupa ce e scrisa
+}
+
+static void timer_task(void)
+{
+    while (1) {
+        rtos_sem_wait(&timer_task_sem);
+
+        while (timer_queue_tail != timer_queue_head) {
+            uint32_t tail = timer_queue_tail;
+            // intrarea se citeste abia dupa ce am vazut head-ul publicat
+            port_memory_barrier();
+            timer_queue_entry_t e = timer_queue[tail & TIMER_QUEUE_MASK];
+            port_memory_barrier();
+            timer_queue_tail = tail + 1u;
+
+            // oprit / repornit dupa ce a expirat: intrarea e veche
+            if (e.gen != e.timer->gen) continue;
+
+            // context de thread: callback-ul poate folosi si API-uri blocante
+            if (e.timer->callback) e.timer->callback();
+        }
+    }
+}
+#endif
+
 // Funcții pentru accesare statistici determinism
 uint32_t rtos_get_context_switch_cycles(void) { 
     return last_cs_cycles; 
@@ -621,6 +2164,31 @@ uint32_t rtos_get_max_context_switch_cycles(void) {
     return max_cs_cycles; 
 }
 
+void rtos_get_cs_stats(rtos_cs_stats_t *out)
+{
+    // copie consistenta: PendSV nu poate rula in timpul copierii
+    uint32_t irq = port_enter_critical();
+    out->last = last_cs_cycles;
+    out->min = count_cs ? min_cs_cycles : 0;
+    out->max = max_cs_cycles;
+    out->count = count_cs;
+    out->mean = count_cs ? (uint32_t)(sum_cs_cycles / count_cs) : 0;
+    for (uint32_t i = 0; i < RTOS_CS_HIST_BUCKETS; i++) out->hist[i] = hist_cs[i];
+    port_exit_critical(irq);
+}
+
+void rtos_reset_cs_stats(void)
+{
+    uint32_t irq = port_enter_critical();
+    last_cs_cycles = 0;
+    max_cs_cycles = 0;
+    min_cs_cycles = 0xFFFFFFFFu;
+    sum_cs_cycles = 0;
+    count_cs = 0;
+    for (uint32_t i = 0; i < RTOS_CS_HIST_BUCKETS; i++) hist_cs[i] = 0;
+    port_exit_critical(irq);
+}
+
 uint32_t rtos_get_isr_latency_cycles(void) {
     // Returnează diferența în tick-uri (ar trebui 1 mereu)
     return isr_latency_cycles;
@@ -628,4 +2196,13 @@ uint32_t rtos_get_isr_latency_cycles(void) {
 
 uint32_t rtos_get_max_isr_latency_cycles(void) {
     return max_isr_latency_cycles;
+}
+
+// durata SysTick_Handler (cicluri DWT), masurata in startup.c
+uint32_t rtos_get_tick_isr_cycles(void) {
+    return tick_isr_cycles;
+}
+
+uint32_t rtos_get_max_tick_isr_cycles(void) {
+    return max_tick_isr_cycles;
 }
\ No newline at end of file
@@ -19,7 +19,11 @@ typedef enum {
     TASK_DELAYED,
     TASK_BLOCKED_SEM,
     TASK_BLOCKED_MUTEX,
-    TASK_BLOCKED_QUEUE
+    TASK_BLOCKED_QUEUE,
+    TASK_BLOCKED_POOL,
+    TASK_BLOCKED_MBOX,
+    TASK_BLOCKED_EVENT,
+    TASK_BLOCKED_NOTIFY
 } task_state_t;
 
 typedef enum {
@@ -28,6 +32,26 @@ typedef enum {
     RTOS_WAIT_TIMEOUT
 } rtos_wait_result_t;
 
+struct rtos_tcb;
+struct rtos_mutex;
+
+// ----------------------------------------------
+// Verificari de debug
+// ----------------------------------------------
+#if RTOS_DEBUG
+void rtos_assert_failed(const char *file, uint32_t line);
+#define RTOS_ASSERT(cond) do { if (!(cond)) rtos_assert_failed(__FILE__, __LINE__); } while (0)
+#else
+#define RTOS_ASSERT(cond) ((void)0)
+#endif
+
+// ----------------------------------------------
+// Wait List (intrusiva, sortata dupa eff_priority)
+// ----------------------------------------------
+typedef struct rtos_wait_list {
+    struct rtos_tcb *head;      // waiter-ul cu cea mai mare prioritate efectiva
+} rtos_wait_list_t;
+
 // ----------------------------------------------
 // Task Control Block
 // ----------------------------------------------
@@ -36,15 +60,58 @@ typedef struct rtos_tcb{
 
     uint32_t base_priority;     // prioritate fixa (nu se schimba)
     uint32_t eff_priority;      // prioritate efectiva (PI/ceiling), folosita de scheduler
+    uint32_t ready_prio;        // nivelul din ready_lists in care e legat (!= eff doar la task-ul curent)
 
     task_state_t state;
 
-    uint32_t wake_tick;         // pentru delay / timeout management
+    uint32_t wake_tick;         // pentru delay / timeout management (valid doar in delay_list)
 
     void *wait_obj;             // sem/mutex/queue
     rtos_wait_result_t wait_res;// PENDING/ OK / TIMEOUT
+    volatile uint32_t notify_value;     // notificare directa (fara obiect partajat)
+    volatile uint32_t notify_pending;   // 1 = notificat si inca neconsumat
+    uint32_t event_bits;        // event group: bitii asteptati; la trezire, valoarea care i-a satisfacut
+    uint32_t event_opts;        // RTOS_EVENT_WAIT_ALL / RTOS_EVENT_CLEAR
 
-    struct rtos_tcb *next;      // pt ready/delay lists
+    struct rtos_tcb *next;      // ready list (circulara) sau delay list; un task e in cel mult una
+    struct rtos_tcb *prev;      // scoatere O(1) din oricare din ele
+
+    rtos_wait_list_t *wait_list;    // lista de asteptare pe care e blocat (sau NULL)
+    struct rtos_tcb *wait_next;     // legaturi in wait_list
+    struct rtos_tcb *wait_prev;
+
+    uint32_t slice_used;        // tick-uri consumate din cuanta curenta (round-robin)
+
+    struct rtos_mutex *volatile held_mutexes;   // mutex-urile detinute (PI: eff = max cu waiter-ii lor)
+    struct rtos_mutex *volatile held_pending;   // in curs de luat / eliberat pe calea rapida
+
+#if RTOS_TASK_STATS
+    const char *name;           // optional, pentru tabelul de statistici
+    uint64_t run_cycles;        // cicluri cat a fost task-ul curent
+    uint32_t run_start;         // port_cycles() la ultima intrare pe CPU
+    uint32_t max_run;           // cea mai lunga rulare continua (cicluri)
+    uint32_t switches;          // de cate ori a primit CPU-ul
+    uint32_t preemptions;       // a pierdut CPU-ul fiind inca READY
+    uint32_t blocks;            // a pierdut CPU-ul prin delay / blocare
+#endif
+
+    // task periodic (period != 0), vezi rtos_task_create_periodic()
+    uint32_t period;
+    uint32_t period_deadline;   // deadline relativ la eliberare
+    uint32_t release;           // tick-ul eliberarii job-ului curent (grila fixa)
+    uint32_t jobs;
+    uint32_t period_misses;     // job terminat dupa release + period_deadline
+    uint32_t overruns;          // job terminat dupa urmatoarea eliberare
+    uint32_t worst_response;    // max(sfarsit job - release), tick-uri
+    uint32_t worst_jitter;      // max(pornire job - release), tick-uri
+
+#if RTOS_EDF
+    uint32_t rel_deadline;      // 0 = prioritate fixa; altfel clasa EDF
+    uint32_t deadline;          // deadline absolut al job-ului curent (tick)
+    uint32_t heap_idx;          // pozitia in heap-ul EDF (valid cat e READY)
+    uint32_t deadline_misses;
+    uint32_t job_late;          // miss-ul job-ului curent a fost deja numarat
+#endif
 } rtos_tcb_t;
 
 // ----------------------------------------------
@@ -52,72 +119,291 @@ typedef struct rtos_tcb{
 // ----------------------------------------------
 typedef struct {
     volatile uint32_t count;         // 0 sau 1 pentru semafor binar
-    // Putem adăuga o listă de task-uri care așteaptă acest semafor anume
+    rtos_wait_list_t waiters;        // task-urile blocate pe acest semafor
 } rtos_sem_t;
 
 // ----------------------------------------------
 // Mutex Structure
 // ----------------------------------------------
-typedef struct {
-    volatile uint32_t lock;      // 0 = liber, 1 = ocupat
-    rtos_tcb_t *owner;           // Task-ul care deține mutex-ul
-    uint32_t original_priority;  // Prioritatea reală a owner-ului (pentru restaurare)
+// Doua protocoale, alese la init:
+//  - rtos_mutex_init(): mostenirea prioritatii (PI), tranzitiva pe mutex-uri imbricate
+//  - rtos_mutex_init_ceiling(): plafon imediat (IPCP); owner-ul urca la plafon chiar
+//    la lock, deci niciun task care foloseste mutex-ul nu il mai poate preempta.
+//    Plafonul = prioritatea de baza maxima a task-urilor care il blocheaza.
+// Lock/unlock necontestat pe un mutex PI = un singur port_cas(), fara sectiune
+// critica; kernel-ul intervine doar cand exista (sau au existat) waiter-i.
+// Pe un mutex IPCP = o sectiune critica scurta: ridicarea la plafon e doar
+// notata in eff_priority, task-ul e mutat in ready list abia daca e preemptat,
+// iar unlock cere PendSV doar daca alt task trece acum inaintea lui.
+typedef struct rtos_mutex {
+    volatile uint32_t lock;      // 0 = liber, altfel id-ul owner-ului << 1 | bit 0 = are waiter-i
+    uint32_t ceiling;            // IPCP: prioritatea plafon; 0 = PI
+    struct rtos_mutex *volatile held_next;  // urmatorul mutex detinut de acelasi owner
+    rtos_wait_list_t waiters;    // task-urile blocate pe acest mutex
 } rtos_mutex_t;
 
+// ----------------------------------------------
+// Notificari directe catre task
+// ----------------------------------------------
+typedef enum {
+    RTOS_NOTIFY_NONE = 0,       // doar trezeste, valoarea ramane
+    RTOS_NOTIFY_SET_BITS,       // value |= arg
+    RTOS_NOTIFY_INCREMENT,      // value++ (semafor numarator)
+    RTOS_NOTIFY_OVERWRITE,      // value = arg
+    RTOS_NOTIFY_NO_OVERWRITE    // value = arg, doar daca nu exista deja o notificare pending
+} rtos_notify_action_t;
+
+// rtos_notify_take() trateaza valoarea ca semafor numarator: intoarce doar cand
+// valoarea e nenula (0 = timeout). Notificarile care nu o schimba (NONE, SET_BITS
+// cu 0) nu o fac sa se intoarca; pentru ele, sau pentru biti, se foloseste rtos_notify_wait().
+// Un task nu ar trebui sa amestece give/take cu SET_BITS / OVERWRITE: take vede
+// bitii ca pe un numar.
+
+// ----------------------------------------------
+// Event Group (32 de flag-uri)
+// ----------------------------------------------
+#define RTOS_EVENT_WAIT_ANY 0u      // oricare din bitii ceruti
+#define RTOS_EVENT_WAIT_ALL 1u      // toti bitii ceruti
+#define RTOS_EVENT_CLEAR    2u      // sterge bitii ceruti la iesirea cu succes
+
+typedef struct {
+    volatile uint32_t bits;
+    rtos_wait_list_t waiters;       // fiecare cu masca si optiunile proprii in TCB
+} rtos_event_group_t;
+
 // ----------------------------------------------
 // Message Queue Structure
 // ----------------------------------------------
 typedef struct {
-    uint32_t buffer[8]; 
+    uint32_t buffer[RTOS_QUEUE_LENGTH];
     uint32_t head; //unde scrie
     uint32_t tail; //de unde citeste
-    rtos_sem_t sem_free_slots;  // numara locurile libere Initial 8
-    rtos_sem_t sem_available_msgs; // Initial 0
-    rtos_mutex_t lock;
+    volatile uint32_t count;
+    rtos_wait_list_t tx_waiters;    // producatori blocati pe coada plina
+    rtos_wait_list_t rx_waiters;    // consumatori blocati pe coada goala
 } rtos_queue_t;
 
+// ----------------------------------------------
+// SPSC Queue (un producator, un consumator)
+// ----------------------------------------------
+// Buffer dat de apelant: depth * item_size octeti, depth putere a lui 2.
+// Calea rapida e wait-free; kernel-ul e apelat doar pentru blocare/trezire.
+typedef struct {
+    uint8_t *buffer;
+    uint32_t item_size;
+    uint32_t mask;                  // depth - 1
+    volatile uint32_t head;         // free-running, scris doar de producator
+    volatile uint32_t tail;         // free-running, scris doar de consumator
+    rtos_wait_list_t rx_waiters;    // consumatorul blocat pe coada goala
+    rtos_wait_list_t tx_waiters;    // producatorul blocat pe coada plina
+} rtos_spsc_queue_t;
+
+typedef enum {
+    RTOS_TIMER_AUTO_RELOAD = 0,   // re-armat automat cu period_ticks
+    RTOS_TIMER_ONE_SHOT           // se opreste dupa prima expirare
+} rtos_timer_mode_t;
+
+// ----------------------------------------------
+// Memory Pool (blocuri de dimensiune fixa) + Mailbox zero-copy
+// ----------------------------------------------
+// Fiecare bloc are un header ascuns de RTOS_POOL_HDR octeti: legatura in
+// lista libera sau in coada unui mailbox. Payload-ul ramane aliniat la 8.
+typedef struct rtos_block {
+    struct rtos_block *next;
+} rtos_block_t;
+
+#define RTOS_POOL_HDR 8u
+#define RTOS_POOL_STRIDE(block_size) ((((block_size) + 7u) & ~7u) + RTOS_POOL_HDR)
+
+// zona statica pentru un pool: RTOS_POOL_STORAGE(rx_frames, 256, 8);
+#define RTOS_POOL_STORAGE(name, block_size, block_count) \
+    static uint8_t name[RTOS_POOL_STRIDE(block_size) * (block_count)] __attribute__((aligned(8)))
+
+typedef struct {
+    rtos_block_t *free_list;
+    uint8_t *start;             // limitele zonei (verificare la free)
+    uint8_t *end;
+    uint32_t stride;
+    uint32_t block_size;
+    volatile uint32_t free_count;
+    rtos_wait_list_t waiters;   // task-uri blocate in alloc pe pool gol
+} rtos_pool_t;
+
+typedef struct {
+    rtos_block_t *head;         // FIFO de blocuri (mesaje)
+    rtos_block_t *tail;
+    volatile uint32_t count;
+    rtos_wait_list_t waiters;
+} rtos_mbox_t;
+
+// ----------------------------------------------
+// Statistici context switch (cicluri DWT in PendSV_Handler)
+// ----------------------------------------------
+#define RTOS_CS_HIST_BUCKETS 32
+
+typedef struct {
+    uint32_t last;
+    uint32_t min;
+    uint32_t max;
+    uint32_t mean;              // medie pe toate switch-urile masurate
+    uint32_t count;
+    uint32_t hist[RTOS_CS_HIST_BUCKETS]; // hist[i] = durate in [2^i, 2^(i+1))
+} rtos_cs_stats_t;
+
 typedef struct rtos_timer {
     uint32_t period_ticks;
-    uint32_t remaining_ticks;
+    uint32_t expiry_tick;       // tick absolut al urmatoarei expirari
     void (*callback)(void);
     uint8_t active;
-    struct rtos_timer *next;
+    uint8_t mode;               // rtos_timer_mode_t
+    struct rtos_timer *next;    // legaturi in slot-ul din timer wheel
+    struct rtos_timer *prev;
+#if RTOS_TIMER_TASK
+    volatile uint32_t gen;      // ++ la start/stop: expirarile din coada daemon-ului devin invalide
+#endif
 } rtos_timer_t;
 
+// ----------------------------------------------
+// Statistici task periodic
+// ----------------------------------------------
+typedef struct {
+    uint32_t period;
+    uint32_t deadline;
+    uint32_t jobs;              // job-uri terminate
+    uint32_t misses;
+    uint32_t overruns;          // inclusiv eliberarile sarite
+    uint32_t worst_response;
+    uint32_t worst_jitter;
+} rtos_periodic_stats_t;
+
+// ----------------------------------------------
+// Snapshot statistici task-uri
+// ----------------------------------------------
+typedef struct {
+    const char *name;           // NULL daca nu a fost setat
+    uint32_t id;                // index in pool + 1 (ca in trace)
+    uint32_t base_priority;
+    uint32_t eff_priority;
+    task_state_t state;
+    uint32_t is_idle;           // task-ul care apeleaza rtos_idle_sleep()
+    uint64_t cycles;
+    uint32_t switches;
+    uint32_t preemptions;
+    uint32_t blocks;
+    uint32_t max_run;
+} rtos_task_stats_t;
+
 // ----------------------------------------------
 // API
 // ----------------------------------------------
 void rtos_init();
-void rtos_task_create(void (*task_fn)(void), uint32_t priority);
+// NULL daca pool-ul e plin sau (cu RTOS_EDF) priority == RTOS_EDF_PRIORITY, nivel rezervat
+rtos_tcb_t *rtos_task_create(void (*task_fn)(void), uint32_t priority);
+rtos_tcb_t *rtos_task_current(void);
+void rtos_task_set_name(rtos_tcb_t *t, const char *name);
+#if RTOS_EDF
+// job nou (deadline = acum + rel_deadline) la creare si la fiecare trezire din
+// delay / sem / coada; blocarea pe mutex face parte din acelasi job
+rtos_tcb_t *rtos_task_create_edf(void (*task_fn)(void), uint32_t rel_deadline_ticks);
+uint32_t rtos_task_deadline_misses(const rtos_tcb_t *t);
+uint32_t rtos_get_deadline_misses(void);     // total, toate task-urile EDF
+#endif
+// prima eliberare la acum + offset, apoi la fiecare `period` tick-uri;
+// deadline 0 = period; priority == RTOS_EDF_PRIORITY -> clasa EDF
+rtos_tcb_t *rtos_task_create_periodic(void (*task_fn)(void), uint32_t priority,
+                                      uint32_t period, uint32_t offset, uint32_t deadline);
+int rtos_wait_next_period(void);             // 1 daca job-ul care s-a terminat si-a ratat deadline-ul
+int rtos_task_get_periodic_stats(const rtos_tcb_t *t, rtos_periodic_stats_t *out);
+void rtos_set_deadline_miss_hook(void (*hook)(rtos_tcb_t *t));  // apelat din task-ul intarziat
+void rtos_set_assert_hook(void (*hook)(const char *file, uint32_t line));   // RTOS_DEBUG
 void rtos_scheduler_next(void);                       
 void rtos_start();
 void rtos_delay(uint32_t ticks);
 void rtos_tick_handler();
 uint32_t rtos_now();
-void rtos_yield();   //forteaza switch ul
+void rtos_yield();   //forteaza switch ul (si cedeaza CPU-ul task-urilor de aceeasi prioritate)
+// variantele *_from_isr nu blocheaza niciodata; *woken devine 1 daca un task trezit
+// trebuie sa ruleze inaintea celui intrerupt (woken NULL = PendSV cerut direct).
+// La sfarsitul ISR-ului: rtos_yield_from_isr(woken) -> un singur PendSV, la iesire
+void rtos_yield_from_isr(uint32_t woken);
+void rtos_set_time_slice(uint32_t priority, uint32_t ticks);  // dupa rtos_init(); 0 = fara rotire
+uint32_t rtos_task_slice_used(const rtos_tcb_t *t);
+void rtos_idle_sleep(void); // apelat din bucla task-ului idle (tickless idle)
+uint32_t rtos_is_running(void);  // 1 dupa rtos_start()
 //semafor 
 void rtos_sem_init(rtos_sem_t *sem, uint32_t initial_count);
 void rtos_sem_wait(rtos_sem_t *sem);   // Functie blocanta 
 int rtos_sem_wait_timeout(rtos_sem_t *sem, uint32_t timeout_ticks);
 int rtos_mutex_lock_timeout(rtos_mutex_t *mutex, uint32_t timeout_ticks);
 void rtos_sem_signal(rtos_sem_t *sem); // Elibereaza semaforul
+void rtos_sem_signal_from_isr(rtos_sem_t *sem, uint32_t *woken);
 //mutex
 void rtos_mutex_init(rtos_mutex_t *mutex);
+// 1 (mutex neinitializat) daca ceiling >= RTOS_MAX_PRIORITIES; ceiling 0 = PI, ca rtos_mutex_init()
+int rtos_mutex_init_ceiling(rtos_mutex_t *mutex, uint32_t ceiling);
 void rtos_mutex_lock(rtos_mutex_t *mutex);
 void rtos_mutex_unlock(rtos_mutex_t *mutex);
+rtos_tcb_t *rtos_mutex_owner(const rtos_mutex_t *mutex);    // NULL = liber
 //coada de mesaje
 void rtos_queue_init(rtos_queue_t *q);
 void rtos_queue_send(rtos_queue_t *q, uint32_t msg);
 int rtos_queue_send_timeout(rtos_queue_t *q, uint32_t msg, uint32_t timeout_ticks);
 int rtos_queue_receive_timeout(rtos_queue_t *q, uint32_t *out, uint32_t timeout_ticks);
 uint32_t rtos_queue_receive(rtos_queue_t *q);
+int rtos_queue_send_from_isr(rtos_queue_t *q, uint32_t msg, uint32_t *woken);       // 1 = plina
+int rtos_queue_receive_from_isr(rtos_queue_t *q, uint32_t *out, uint32_t *woken);   // 1 = goala
+//coada SPSC (0 = OK, 1 = plina/goala la timeout sau parametri invalizi)
+int rtos_spsc_init(rtos_spsc_queue_t *q, void *buffer, uint32_t item_size, uint32_t depth);
+int rtos_spsc_send(rtos_spsc_queue_t *q, const void *item, uint32_t timeout_ticks);
+int rtos_spsc_receive(rtos_spsc_queue_t *q, void *out, uint32_t timeout_ticks);
+uint32_t rtos_spsc_count(const rtos_spsc_queue_t *q);
+//notificari directe
+int rtos_notify(rtos_tcb_t *t, uint32_t arg, rtos_notify_action_t action);  // 1 = NO_OVERWRITE respins
+void rtos_notify_give(rtos_tcb_t *t);                                        // RTOS_NOTIFY_INCREMENT
+int rtos_notify_from_isr(rtos_tcb_t *t, uint32_t arg, rtos_notify_action_t action, uint32_t *woken);
+void rtos_notify_give_from_isr(rtos_tcb_t *t, uint32_t *woken);
+uint32_t rtos_notify_take(uint32_t clear, uint32_t timeout_ticks);          // valoarea dinainte, 0 la timeout
+int rtos_notify_wait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                     uint32_t *out_value, uint32_t timeout_ticks);          // 0 = OK, 1 = timeout
+//event group (clear sigur si din ISR; wait: 0 = OK, 1 = timeout)
+void rtos_event_init(rtos_event_group_t *eg);
+uint32_t rtos_event_set(rtos_event_group_t *eg, uint32_t bits);     // valoarea dupa set (si stergerile waiter-ilor)
+uint32_t rtos_event_set_from_isr(rtos_event_group_t *eg, uint32_t bits, uint32_t *woken);
+uint32_t rtos_event_clear(rtos_event_group_t *eg, uint32_t bits);   // valoarea dinainte
+uint32_t rtos_event_get(const rtos_event_group_t *eg);
+int rtos_event_wait(rtos_event_group_t *eg, uint32_t bits, uint32_t opts,
+                    uint32_t *out_bits, uint32_t timeout_ticks);    // *out_bits = valoarea care a satisfacut
+//memory pool (alloc/free sunt sigure si din ISR cu timeout 0)
+int rtos_pool_init(rtos_pool_t *pool, void *storage, uint32_t block_size, uint32_t block_count);
+void *rtos_pool_alloc(rtos_pool_t *pool, uint32_t timeout_ticks);   // NULL la timeout
+int rtos_pool_free(rtos_pool_t *pool, void *block);
+uint32_t rtos_pool_free_count(const rtos_pool_t *pool);
+//mailbox: trece proprietatea unui bloc din pool fara copiere
+void rtos_mbox_init(rtos_mbox_t *mbox);
+void rtos_mbox_post(rtos_mbox_t *mbox, void *msg);
+void *rtos_mbox_fetch(rtos_mbox_t *mbox, uint32_t timeout_ticks);  // NULL la timeout
 //
 void rtos_timer_init(rtos_timer_t *timer, uint32_t period_ms, void (*callback)(void));
+void rtos_timer_init_mode(rtos_timer_t *timer, uint32_t period_ms, void (*callback)(void),
+                          rtos_timer_mode_t mode);
 void rtos_timer_start(rtos_timer_t *timer);
 void rtos_timer_stop(rtos_timer_t *timer);
+uint32_t rtos_timer_get_dropped(void);  // expirari pierdute (coada timer task plina)
 // Statistici Determinism
 uint32_t rtos_get_context_switch_cycles(void);
 uint32_t rtos_get_max_context_switch_cycles(void);
+void rtos_get_cs_stats(rtos_cs_stats_t *out);
+void rtos_reset_cs_stats(void);
+void rtos_dump_cs_stats(void);      // tabel pe UART (rtos_stats.c)
+#if RTOS_TASK_STATS
+// copie consistenta (in sectiune critica) a contoarelor, inclusiv rularea in curs;
+// intoarce numarul de task-uri scrise, *total_cycles = suma ciclurilor tuturor
+uint32_t rtos_get_task_stats(rtos_task_stats_t *out, uint32_t max, uint64_t *total_cycles);
+void rtos_reset_task_stats(void);
+void rtos_dump_task_stats(void);    // tabel "top" pe UART (rtos_stats.c)
+#endif
 uint32_t rtos_get_isr_latency_cycles(void);
 uint32_t rtos_get_max_isr_latency_cycles(void);
+uint32_t rtos_get_tick_isr_cycles(void);
+uint32_t rtos_get_max_tick_isr_cycles(void);
 #endif
\ No newline at end of file
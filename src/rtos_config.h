@@ -4,8 +4,70 @@
 #define RTOS_TICK_RATE_HZ 1000  // 1 ms
 #define CPU_CLOCK_HZ 48000000   // 48 MHz
 
+#ifndef RTOS_MAX_TASKS
 #define RTOS_MAX_TASKS 6
+#endif
 #define RTOS_MAX_PRIORITIES 32
+#ifdef RTOS_PORT_POSIX
+#define RTOS_STACK_SIZE 16384           // pe host handler-ul de semnal ruleaza pe stiva task-ului
+#else
 #define RTOS_STACK_SIZE 512
+#endif
+#define RTOS_QUEUE_LENGTH 8             // adancimea rtos_queue_t (mesaje uint32_t)
+
+// Sectiuni critice ale kernel-ului (Cortex-M3): BASEPRI = RTOS_MAX_SYSCALL_PRIORITY.
+// Valoare de registru de prioritate (STM32F4 foloseste 4 biti: 0x10, 0x20, ...).
+// Intreruperile cu prioritate numerica < aceasta valoare nu sunt mascate niciodata
+// de kernel, dar nu au voie sa apeleze API-ul RTOS; SysTick, PendSV si orice ISR
+// care apeleaza kernel-ul trebuie sa aiba prioritate numerica >= aceasta valoare.
+#define RTOS_MAX_SYSCALL_PRIORITY 0x40
+
+// Round-robin intre task-urile READY de aceeasi prioritate: cuanta implicita in
+// tick-uri (0 = fara rotire); se poate schimba per nivel cu rtos_set_time_slice()
+#define RTOS_TIME_SLICE_TICKS 10
+
+// EDF: task-urile create cu rtos_task_create_edf() stau toate pe nivelul
+// RTOS_EDF_PRIORITY si sunt ordonate intre ele dupa deadline-ul absolut
+// (heap); restul nivelurilor raman cu prioritati fixe. Nivelul e rezervat:
+// rtos_task_create() refuza prioritatea RTOS_EDF_PRIORITY
+#ifndef RTOS_EDF
+#define RTOS_EDF 1
+#endif
+#define RTOS_EDF_PRIORITY (RTOS_MAX_PRIORITIES - 2)
+
+// Soft timers: roata hashed, slot = expiry_tick % RTOS_TIMER_WHEEL_SIZE (putere a lui 2)
+#define RTOS_TIMER_WHEEL_SIZE 64
+
+// Timer service task: callback-urile ruleaza intr-un task daemon, nu in SysTick
+#ifndef RTOS_TIMER_TASK
+#define RTOS_TIMER_TASK 0
+#endif
+#define RTOS_TIMER_TASK_PRIORITY (RTOS_MAX_PRIORITIES - 1)
+#define RTOS_TIMER_QUEUE_SIZE 16        // putere a lui 2
+
+// Statistici per task (cicluri CPU, switch-uri, preemptiuni, blocari), vezi rtos_get_task_stats()
+#define RTOS_TASK_STATS 1
+
+// Verificari de consistenta in kernel (RTOS_ASSERT): la esec apeleaza hook-ul
+// setat cu rtos_set_assert_hook() sau se opreste cu IRQ-urile kernel-ului mascate
+#ifndef RTOS_DEBUG
+#define RTOS_DEBUG 1
+#endif
+
+// Trace recorder binar (vezi trace.h); 0 = compilat complet in afara
+// (make trace / make run-host-trace construiesc varianta cu RTOS_TRACE=1)
+#ifndef RTOS_TRACE
+#define RTOS_TRACE 0
+#endif
+#define RTOS_TRACE_BUF_SIZE 1024        // inregistrari de 8 octeti, putere a lui 2
+
+// Tickless idle: cand doar idle-ul e READY, SysTick e reprogramat pana la
+// urmatorul eveniment (delay/timeout/soft timer) si CPU-ul doarme cu WFI
+#define RTOS_TICKLESS_IDLE 1
+#ifdef RTOS_PORT_POSIX
+#define RTOS_TICKLESS_MIN_IDLE_TICKS 1   // pe host "somnul" e gratuit: timp virtual
+#else
+#define RTOS_TICKLESS_MIN_IDLE_TICKS 2   // sub acest prag nu merita oprit tick-ul
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "rtos.h"
+#include "uart.h"
+
+// ----------------------------------------------
+// Afisare statistici kernel pe UART
+// ----------------------------------------------
+void rtos_dump_cs_stats(void)
+{
+    rtos_cs_stats_t st;
+    rtos_get_cs_stats(&st);
+
+    uart_puts("[CS] count=");
+    uart_print_uint(st.count);
+    uart_puts(" last=");
+    uart_print_uint(st.last);
+    uart_puts(" min=");
+    uart_print_uint(st.min);
+    uart_puts(" mean=");
+    uart_print_uint(st.mean);
+    uart_puts(" max=");
+    uart_print_uint(st.max);
+    uart_puts(" cycles\n");
+
+    // histograma log2: doar intervalele populate
+    for (uint32_t i = 0; i < RTOS_CS_HIST_BUCKETS; i++) {
+        if (st.hist[i] == 0) continue;
+        uart_puts("[CS]   ");
+        uart_print_uint(1u << i);
+        uart_puts("..");
+        uart_print_uint((i < 31) ? (1u << (i + 1)) - 1u : 0xFFFFFFFFu);
+        uart_puts(": ");
+        uart_print_uint(st.hist[i]);
+        uart_puts("\n");
+    }
+}
+
+#if RTOS_TASK_STATS
+// ----------------------------------------------
+// Tabel "top" per task
+// ----------------------------------------------
+static rtos_task_stats_t top_snap[RTOS_MAX_TASKS];   // static: nu incarcam stiva apelantului
+
+static const char *state_name(task_state_t st)
+{
+    switch (st) {
+    case TASK_READY:          return "READY";
+    case TASK_DELAYED:        return "DELAY";
+    case TASK_BLOCKED_SEM:    return "SEM";
+    case TASK_BLOCKED_MUTEX:  return "MUTEX";
+    case TASK_BLOCKED_QUEUE:  return "QUEUE";
+    case TASK_BLOCKED_POOL:   return "POOL";
+    case TASK_BLOCKED_MBOX:   return "MBOX";
+    case TASK_BLOCKED_EVENT:  return "EVENT";
+    case TASK_BLOCKED_NOTIFY: return "NOTIFY";
+    default:                  return "?";
+    }
+}
+
+static void put_str(const char *s, uint32_t width)
+{
+    uint32_t n = 0;
+    while (s[n]) n++;
+    uart_puts(s);
+    while (n++ < width) uart_putc(' ');
+}
+
+// aliniat la dreapta pe `width` coloane
+static void put_uint(uint32_t val, uint32_t width)
+{
+    uint32_t digits = 1;
+    for (uint32_t v = val; v >= 10; v /= 10) digits++;
+    while (digits++ < width) uart_putc(' ');
+    uart_print_uint(val);
+}
+
+static void put_u64(uint64_t val)
+{
+    char buf[21];
+    int i = 0;
+
+    do {
+        buf[i++] = (char)('0' + (uint32_t)(val % 10u));
+        val /= 10u;
+    } while (val);
+    while (i > 0) uart_putc(buf[--i]);
+}
+
+// procent cu o zecimala din partea / total
+static void put_percent(uint64_t part, uint64_t total, uint32_t width)
+{
+    uint32_t permille = total ? (uint32_t)((part * 1000u + total / 2u) / total) : 0;
+    put_uint(permille / 10u, width - 2u);
+    uart_putc('.');
+    uart_print_uint(permille % 10u);
+}
+
+void rtos_dump_task_stats(void)
+{
+    uint64_t total;
+    uint32_t n = rtos_get_task_stats(top_snap, RTOS_MAX_TASKS, &total);
+
+    // sarcina CPU = tot ce nu a consumat task-ul idle
+    uint64_t idle = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (top_snap[i].is_idle) idle += top_snap[i].cycles;
+    }
+
+    uart_puts("[TOP] load=");
+    put_percent(total - idle, total, 3);
+    uart_puts("% window=");
+    put_u64(total);
+    uart_puts(" cycles\n");
+    uart_puts("[TOP]  id name         prio  state   cpu%  switches  preempt   blocks  max_run\n");
+
+    for (uint32_t i = 0; i < n; i++) {
+        rtos_task_stats_t *s = &top_snap[i];
+
+        uart_puts("[TOP] ");
+        put_uint(s->id, 3);
+        uart_putc(' ');
+        put_str(s->name ? s->name : (s->is_idle ? "idle" : "-"), 12);
+        uart_putc(' ');
+
+        // prioritatea efectiva apare doar daca difera (PI)
+        put_uint(s->base_priority, 2);
+        if (s->eff_priority != s->base_priority) {
+            uart_putc('^');
+            put_uint(s->eff_priority, 2);
+        } else {
+            uart_puts("   ");
+        }
+        uart_putc(' ');
+        put_str(state_name(s->state), 6);
+        put_percent(s->cycles, total, 6);
+        put_uint(s->switches, 10);
+        put_uint(s->preemptions, 9);
+        put_uint(s->blocks, 9);
+        put_uint(s->max_run, 9);
+        uart_puts("\n");
+    }
+}
+#endif
@@ -1,10 +1,14 @@
 #include "rtos.h"
+#include "uart.h"
+#include "trace.h"
 
 #define DWT_CYCCNT   (*(volatile uint32_t *)0xE0001004)
 
 // Declarații externe pentru statistici din rtos.c
 extern volatile uint32_t isr_latency_cycles;
 extern volatile uint32_t max_isr_latency_cycles;
+extern volatile uint32_t tick_isr_cycles;
+extern volatile uint32_t max_tick_isr_cycles;
 extern volatile uint32_t g_tick;
 extern uint32_t _estack;
 extern uint32_t _sidata;  // start init values for .data (in FLASH)
@@ -43,6 +47,8 @@ void (* const vector_table[])(void) = {
     0,                            // 13: rezervat
     PendSV_Handler,              // 14: PendSV
     SysTick_Handler,              // 15: SysTick
+    [16 ... 52] = Default_Handler, // IRQ 0–36
+    USART1_IRQHandler,            // IRQ 37: USART1
 };
 
 // ----------------------------------------------
@@ -77,10 +83,13 @@ void Reset_Handler(){
 void SysTick_Handler()
 {
     static uint32_t last_entry = 0;
+    static uint32_t last_tick = 0;
 
     uint32_t entry = DWT_CYCCNT;
+    TRACE_EVENT(TRACE_ISR_ENTER, 0, TRACE_IRQ_SYSTICK);
 
-    if (last_entry != 0) {
+    // dupa un tickless idle intervalul nu mai e o perioada -> nu e jitter
+    if (last_entry != 0 && g_tick == last_tick) {
         uint32_t expected = (CPU_CLOCK_HZ / RTOS_TICK_RATE_HZ);
         uint32_t delta = entry - last_entry;
 
@@ -93,8 +102,12 @@ void SysTick_Handler()
     last_entry = entry;
 
     rtos_tick_handler();
+    last_tick = g_tick;
 
-    // uint32_t dur = DWT_CYCCNT - entry;
+    uint32_t dur = DWT_CYCCNT - entry;
+    tick_isr_cycles = dur;
+    if (dur > max_tick_isr_cycles) max_tick_isr_cycles = dur;
+    TRACE_EVENT(TRACE_ISR_EXIT, 0, TRACE_IRQ_SYSTICK);
 }
 
 void HardFault_Handler()
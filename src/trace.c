@@ -0,0 +1,32 @@
+#include "trace.h"
+#include "port.h"
+
+#if RTOS_TRACE
+
+#define TRACE_MASK (RTOS_TRACE_BUF_SIZE - 1u)
+
+// in .bss: header-ul se completeaza in trace_init(), nu ocupa FLASH
+rtos_trace_buf_t rtos_trace;
+
+void trace_init(void)
+{
+    rtos_trace.magic = RTOS_TRACE_MAGIC;
+    rtos_trace.cpu_hz = CPU_CLOCK_HZ;
+    rtos_trace.size = RTOS_TRACE_BUF_SIZE;
+    rtos_trace.idx = 0;
+}
+
+// apelabil din task-uri si ISR-uri (sub RTOS_MAX_SYSCALL_PRIORITY); cateva zeci de cicluri
+void trace_record(uint32_t event, uint32_t task, uint32_t obj)
+{
+    // timestamp-ul si slotul in aceeasi sectiune critica: un ISR intre ele ar
+    // scrie slotul urmator cu un timestamp mai vechi (ordinea din ring = ordinea ts)
+    uint32_t irq = port_enter_critical();
+    uint32_t i = rtos_trace.idx++;
+    rtos_trace_rec_t *r = &rtos_trace.rec[i & TRACE_MASK];
+    r->ts = port_cycles();
+    r->info = (event << 24) | ((task & 0xFFu) << 16) | (obj & 0xFFFFu);
+    port_exit_critical(irq);
+}
+
+#endif
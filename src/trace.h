@@ -0,0 +1,67 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "rtos_config.h"
+
+// ----------------------------------------------
+// Trace recorder binar (ring in RAM)
+// ----------------------------------------------
+// Inregistrare de 8 octeti: timestamp DWT CYCCNT + [eveniment | task | obiect].
+// Buffer-ul `rtos_trace` se descarca din gdb/QEMU si se decodeaza cu
+// tools/trace_decode.py (JSON Chrome trace / Perfetto).
+// Cu RTOS_TRACE 0 macro-urile dispar complet.
+
+#define RTOS_TRACE_MAGIC 0x43525452u    // "RTRC"
+
+typedef enum {
+    TRACE_TASK_SWITCH = 1,  // task = task-ul care intra pe CPU
+    TRACE_TASK_CREATE,      // obj = prioritate
+    TRACE_TASK_READY,       // trezit (obj = obiectul asteptat)
+    TRACE_TASK_TIMEOUT,     // timeout expirat (obj = obiectul asteptat)
+    TRACE_TASK_BLOCK,       // obj = obiectul pe care se blocheaza
+    TRACE_TASK_DELAY,       // obj = tick-uri
+    TRACE_TASK_PRIORITY,    // obj = noua prioritate efectiva
+    TRACE_TICK,             // obj = g_tick (16 biti)
+    TRACE_ISR_ENTER,        // obj = IRQn ca in CMSIS, 16 biti cu semn (exceptiile: numar - 16)
+    TRACE_ISR_EXIT,
+    TRACE_SEM_GIVE,
+    TRACE_SEM_TAKE,
+    TRACE_MUTEX_LOCK,
+    TRACE_MUTEX_UNLOCK,
+    TRACE_QUEUE_SEND,
+    TRACE_QUEUE_RECEIVE,
+    TRACE_TIMER_EXPIRE,
+    TRACE_EVGROUP_SET,
+    TRACE_EVGROUP_WAIT      // conditie satisfacuta fara blocare
+} trace_event_t;
+
+// IRQn pentru exceptiile de sistem (ca in CMSIS): SysTick e exceptia 15 -> -1
+#define TRACE_IRQ_SYSTICK   ((uint32_t)-1)
+
+typedef struct {
+    uint32_t ts;            // DWT CYCCNT
+    uint32_t info;          // event[31:24] | task[23:16] | obj[15:0]
+} rtos_trace_rec_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t cpu_hz;
+    uint32_t size;          // numar de inregistrari din ring
+    volatile uint32_t idx;  // free-running: urmatoarea pozitie de scris
+    rtos_trace_rec_t rec[RTOS_TRACE_BUF_SIZE];
+} rtos_trace_buf_t;
+
+// id-ul unui obiect kernel: adresa in cuvinte (RAM-ul de 128K incape in 16 biti)
+#define TRACE_OBJ(p) ((uint32_t)(uintptr_t)(p) >> 2)
+
+#if RTOS_TRACE
+extern rtos_trace_buf_t rtos_trace;
+void trace_init(void);
+void trace_record(uint32_t event, uint32_t task, uint32_t obj);
+#define TRACE_EVENT(ev, task, obj) trace_record((ev), (task), (obj))
+#else
+#define TRACE_EVENT(ev, task, obj) ((void)0)
+#endif
+
+#endif
@@ -1,4 +1,6 @@
 #include "uart.h"
+#include "port.h"
+#include "trace.h"
 #include <stdint.h>
 
 #define RCC_AHB1ENR   (*(volatile uint32_t *)0x40023830)
@@ -15,6 +17,45 @@
 #define USART1_CR1    (*(volatile uint32_t *)(USART1_BASE + 0x0C))
 
 #define USART_SR_TXE  (1 << 7)
+#define USART_SR_RXNE (1 << 5)
+#define USART_SR_ORE  (1 << 3)
+#define USART_CR1_TXEIE (1 << 7)
+#define USART_CR1_RXNEIE (1 << 5)
+
+// NVIC: USART1 = IRQ 37
+#define USART1_IRQn   37
+#define NVIC_ISER1    (*(volatile uint32_t *)0xE000E104)
+#define NVIC_IPR_BASE ((volatile uint8_t *)0xE000E400)
+#define USART1_IRQ_PRIO 0xC0            // sub SysTick (0x80), peste PendSV (0xFF)
+
+// ISR-ul semnalizeaza semafoare: trebuie mascat de sectiunile critice ale kernel-ului
+#if USART1_IRQ_PRIO < RTOS_MAX_SYSCALL_PRIORITY
+#error "USART1_IRQ_PRIO trebuie sa fie >= RTOS_MAX_SYSCALL_PRIORITY"
+#endif
+
+#define TX_MASK (UART_TX_BUF_SIZE - 1u)
+
+// ring buffer TX: head scris de task-uri (in sectiune critica), tail doar de ISR
+static volatile uint8_t tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t tx_head = 0;
+static volatile uint32_t tx_tail = 0;
+static volatile uint32_t tx_dropped = 0;
+#if UART_TX_POLICY == UART_TX_POLICY_BLOCK
+static volatile uint32_t tx_waiting = 0;    // task-uri blocate in uart_putc/uart_puts (cate un jeton fiecare)
+static rtos_sem_t tx_space_sem;
+#endif
+
+#define RX_MASK (UART_RX_BUF_SIZE - 1u)
+
+// stream buffer RX: head scris doar de ISR, tail doar de task-ul cititor
+static volatile uint8_t rx_buf[UART_RX_BUF_SIZE];
+static volatile uint32_t rx_head = 0;
+static volatile uint32_t rx_tail = 0;
+static volatile uint32_t rx_overflows = 0;
+// conditia de trezire a cititorului (rx_trigger = 0 -> nu asteapta nimeni)
+static volatile uint32_t rx_trigger = 0;
+static volatile int rx_delim = UART_NO_DELIM;
+static rtos_sem_t rx_sem;
 
 void uart_init(void)
 {
@@ -35,21 +76,245 @@ void uart_init(void)
     // Baud (merge și “aprox” în QEMU)
     USART1_BRR = 417;
 
-    // UE | TE | RE
-    USART1_CR1 = (1 << 13) | (1 << 3) | (1 << 2);
+    // UE | TE | RE | RXNEIE (TXEIE se activeaza doar cand sunt date in buffer)
+    USART1_CR1 = (1 << 13) | (1 << 3) | (1 << 2) | USART_CR1_RXNEIE;
+
+    tx_head = 0;
+    tx_tail = 0;
+#if UART_TX_POLICY == UART_TX_POLICY_BLOCK
+    tx_waiting = 0;
+    rtos_sem_init(&tx_space_sem, 0);
+#endif
+    rx_head = 0;
+    rx_tail = 0;
+    rx_trigger = 0;
+    rtos_sem_init(&rx_sem, 0);
+
+    NVIC_IPR_BASE[USART1_IRQn] = USART1_IRQ_PRIO;
+    NVIC_ISER1 = (1u << (USART1_IRQn - 32));
 }
 
-void uart_putc(char c)
+#if UART_TX_POLICY == UART_TX_POLICY_BLOCK
+// putem astepta pe semafor doar dintr-un task care nu era deja in sectiune
+// critica (irq = starea salvata de apelant) si cu intreruperile active
+static int uart_can_block(uint32_t irq)
+{
+    uint32_t ipsr, primask;
+    __asm volatile("mrs %0, ipsr" : "=r"(ipsr));
+    __asm volatile("mrs %0, primask" : "=r"(primask));
+    return rtos_is_running() && ipsr == 0 && primask == 0 && irq == 0;
+}
+#endif
+
+// buffer plin si TXE nu poate rula (ISR, sectiune critica): trimitem cel mai vechi octet de mana
+static void uart_tx_drain_one(void)
 {
     while (!(USART1_SR & USART_SR_TXE)) {}
-    USART1_DR = (uint32_t)c;
+    USART1_DR = tx_buf[tx_tail & TX_MASK];
+    tx_tail++;
+}
+
+// copiaza cat incape din buf in ring si porneste TXE (in sectiune critica)
+static uint32_t uart_tx_copy_locked(const char *buf, uint32_t len)
+{
+    uint32_t space = UART_TX_BUF_SIZE - (tx_head - tx_tail);
+    uint32_t n = (len < space) ? len : space;
+    for (uint32_t i = 0; i < n; i++) {
+        tx_buf[(tx_head + i) & TX_MASK] = (uint8_t)buf[i];
+    }
+    tx_head += n;
+    if (n) USART1_CR1 |= USART_CR1_TXEIE;
+    return n;
+}
+
+// tot buf, pe bucati: o sectiune critica per bucata copiata, nu per octet;
+// cu buffer-ul plin se aplica UART_TX_POLICY pentru restul
+static void uart_tx_put(const char *buf, uint32_t len)
+{
+    while (1) {
+        uint32_t irq = port_enter_critical();
+
+        uint32_t n = uart_tx_copy_locked(buf, len);
+        buf += n;
+        len -= n;
+        if (len == 0) {
+            port_exit_critical(irq);
+            return;
+        }
+
+#if UART_TX_POLICY == UART_TX_POLICY_BLOCK
+        if (uart_can_block(irq)) {
+            // ISR-ul semnalizeaza cand s-a golit jumatate de buffer; un jeton
+            // dat inainte sa apucam sa asteptam ramane in semafor
+            tx_waiting++;
+            port_exit_critical(irq);
+            rtos_sem_wait(&tx_space_sem);
+            continue;
+        }
+        // boot / ISR / sectiune critica: golim sincron
+        uart_tx_drain_one();
+        port_exit_critical(irq);
+#else
+        tx_dropped += len;
+        port_exit_critical(irq);
+        return;
+#endif
+    }
+}
+
+void uart_putc(char c)
+{
+    uart_tx_put(&c, 1);
+}
+
+uint32_t uart_write(const char *buf, uint32_t len)
+{
+    uint32_t irq = port_enter_critical();
+    uint32_t n = uart_tx_copy_locked(buf, len);
+    port_exit_critical(irq);
+    return n;
+}
+
+uint32_t uart_tx_dropped(void)
+{
+    return tx_dropped;
+}
+
+// ----------------------------------------------
+// RX
+// ----------------------------------------------
+// cati octeti poate lua cititorul: pana la delimitator inclusiv, sau tot ce e disponibil
+static uint32_t rx_ready_len(uint32_t avail, int delim, int *found)
+{
+    *found = 0;
+    if (delim != UART_NO_DELIM) {
+        for (uint32_t i = 0; i < avail; i++) {
+            if (rx_buf[(rx_tail + i) & RX_MASK] == (uint8_t)delim) {
+                *found = 1;
+                return i + 1u;
+            }
+        }
+    }
+    return avail;
+}
+
+uint32_t uart_read(uint8_t *buf, uint32_t max, uint32_t trigger, int delim, uint32_t timeout_ticks)
+{
+    if (max == 0) return 0;
+    if (trigger == 0) trigger = 1;
+    if (trigger > max) trigger = max;
+    if (trigger > UART_RX_BUF_SIZE) trigger = UART_RX_BUF_SIZE;
+
+    uint32_t start = rtos_now();
+    uint32_t avail, len;
+    int found;
+
+    while (1) {
+        avail = rx_head - rx_tail;
+        len = rx_ready_len(avail, delim, &found);
+        if (found || avail >= trigger || timeout_ticks == 0) break;
+
+        uint32_t left = 0xFFFFFFFFu;
+        if (timeout_ticks != 0xFFFFFFFFu) {
+            uint32_t waited = rtos_now() - start;
+            if (waited >= timeout_ticks) break;
+            left = timeout_ticks - waited;
+        }
+
+        // armam conditia pentru ISR, apoi re-verificam: octetii sositi intre timp
+        // nu ar mai declansa semnalizarea
+        uint32_t irq = port_enter_critical();
+        rx_delim = delim;
+        rx_trigger = trigger;
+        port_exit_critical(irq);
+
+        avail = rx_head - rx_tail;
+        (void)rx_ready_len(avail, delim, &found);
+        if (!found && avail < trigger) {
+            (void)rtos_sem_wait_timeout(&rx_sem, left);
+        }
+        rx_trigger = 0;
+    }
+
+    if (len > max) len = max;
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = rx_buf[(rx_tail + i) & RX_MASK];
+    }
+    rx_tail += len;
+    return len;
+}
+
+uint32_t uart_rx_available(void)
+{
+    return rx_head - rx_tail;
+}
+
+uint32_t uart_rx_overflows(void)
+{
+    return rx_overflows;
+}
+
+void USART1_IRQHandler(void)
+{
+    TRACE_EVENT(TRACE_ISR_ENTER, 0, USART1_IRQn);
+    uint32_t woken = 0;
+    uint32_t sr = USART1_SR;
+
+    // citirea DR sterge si RXNE si ORE
+    if (sr & (USART_SR_RXNE | USART_SR_ORE)) {
+        uint8_t byte = (uint8_t)USART1_DR;
+        if (sr & USART_SR_ORE) rx_overflows++;
+
+        uint32_t head = rx_head;
+        if (head - rx_tail < UART_RX_BUF_SIZE) {
+            rx_buf[head & RX_MASK] = byte;
+            rx_head = head + 1u;
+        } else {
+            rx_overflows++;     // cititorul nu tine pasul
+        }
+
+        // o singura trezire per conditie, nu per octet
+        uint32_t trig = rx_trigger;
+        if (trig && ((rx_head - rx_tail) >= trig ||
+                     (rx_delim != UART_NO_DELIM && byte == (uint8_t)rx_delim))) {
+            rx_trigger = 0;
+            rtos_sem_signal_from_isr(&rx_sem, &woken);
+        }
+    }
+
+    if ((USART1_CR1 & USART_CR1_TXEIE) && (USART1_SR & USART_SR_TXE)) {
+        if (tx_tail != tx_head) {
+            USART1_DR = tx_buf[tx_tail & TX_MASK];
+            tx_tail++;
+        } else {
+            USART1_CR1 &= ~USART_CR1_TXEIE;     // nimic de trimis
+        }
+
+#if UART_TX_POLICY == UART_TX_POLICY_BLOCK
+        // trezim toti scriitorii blocati, nu doar unul: altfel restul ar astepta
+        // pana se umple si se goleste din nou buffer-ul (sau la nesfarsit)
+        if ((tx_head - tx_tail) <= UART_TX_BUF_SIZE / 2u) {
+            while (tx_waiting) {
+                tx_waiting--;
+                rtos_sem_signal_from_isr(&tx_space_sem, &woken);
+            }
+        }
+#endif
+    }
+    TRACE_EVENT(TRACE_ISR_EXIT, 0, USART1_IRQn);
+    rtos_yield_from_isr(woken);
 }
 
+// fiecare linie intr-o singura copiere in ring, apoi "\r\n"
 void uart_puts(const char *s)
 {
     while (*s) {
-        if (*s == '\n') uart_putc('\r');
-        uart_putc(*s++);
+        const char *end = s;
+        while (*end && *end != '\n') end++;
+        if (end != s) uart_tx_put(s, (uint32_t)(end - s));
+        if (*end == '\0') return;
+        uart_tx_put("\r\n", 2);
+        s = end + 1;
     }
 }
 
@@ -3,10 +3,39 @@
 
 #include <stdint.h>
 
+// ----------------------------------------------
+// TX bufferizat, golit de intreruperea USART1 (TXE)
+// ----------------------------------------------
+#ifndef UART_TX_BUF_SIZE
+#define UART_TX_BUF_SIZE 256            // putere a lui 2
+#endif
+
+// ce face uart_putc/uart_puts cand buffer-ul e plin
+#define UART_TX_POLICY_DROP  0          // caracterul se pierde (numarat in uart_tx_dropped)
+#define UART_TX_POLICY_BLOCK 1          // task-ul asteapta pe semafor pana se elibereaza loc
+#ifndef UART_TX_POLICY
+#define UART_TX_POLICY UART_TX_POLICY_BLOCK
+#endif
+
+// ----------------------------------------------
+// RX: stream buffer umplut de intreruperea RXNE
+// ----------------------------------------------
+#ifndef UART_RX_BUF_SIZE
+#define UART_RX_BUF_SIZE 256            // putere a lui 2
+#endif
+#define UART_NO_DELIM (-1)
+
 void uart_init(void);
 void uart_putc(char c);
 void uart_puts(const char *s);
 void uart_print_uint(uint32_t val);
 void uart_print_hex(uint32_t val);
+uint32_t uart_write(const char *buf, uint32_t len);   // nu blocheaza, intoarce cati octeti a pus
+uint32_t uart_tx_dropped(void);
+// un singur task cititor; trezit cand sunt >= trigger octeti sau a sosit delim
+uint32_t uart_read(uint8_t *buf, uint32_t max, uint32_t trigger, int delim, uint32_t timeout_ticks);
+uint32_t uart_rx_available(void);
+uint32_t uart_rx_overflows(void);
+void USART1_IRQHandler(void);
 
-#endif
\ No newline at end of file
+#endif
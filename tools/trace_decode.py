@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Decodeaza un dump al bufferului `rtos_trace` in JSON Chrome trace / Perfetto.
+
+Dump din gdb (target QEMU sau placa):
+    (gdb) dump binary memory trace.bin &rtos_trace ((char *)&rtos_trace) + sizeof(rtos_trace)
+
+Decodare:
+    python3 tools/trace_decode.py trace.bin > trace.json
+si se deschide in https://ui.perfetto.dev sau chrome://tracing.
+"""
+
+import json
+import struct
+import sys
+
+MAGIC = 0x43525452  # "RTRC"
+HEADER = struct.Struct("<IIII")
+RECORD = struct.Struct("<II")
+
+# trebuie sa corespunda cu trace_event_t din src/trace.h
+EVENTS = {
+    1: "TASK_SWITCH",
+    2: "TASK_CREATE",
+    3: "TASK_READY",
+    4: "TASK_TIMEOUT",
+    5: "TASK_BLOCK",
+    6: "TASK_DELAY",
+    7: "TASK_PRIORITY",
+    8: "TICK",
+    9: "ISR_ENTER",
+    10: "ISR_EXIT",
+    11: "SEM_GIVE",
+    12: "SEM_TAKE",
+    13: "MUTEX_LOCK",
+    14: "MUTEX_UNLOCK",
+    15: "QUEUE_SEND",
+    16: "QUEUE_RECEIVE",
+    17: "TIMER_EXPIRE",
+    18: "EVGROUP_SET",
+    19: "EVGROUP_WAIT",
+}
+
+PID = 1
+ISR_TID = 1000  # thread-ul pe care apar ISR-urile
+
+# IRQn negativ = exceptie de sistem (numar exceptie - 16), ca in CMSIS si src/trace.h
+EXCEPTIONS = {
+    -14: "NMI",
+    -13: "HardFault",
+    -5: "SVCall",
+    -2: "PendSV",
+    -1: "SysTick",
+}
+
+
+def read_records(data):
+    magic, cpu_hz, size, idx = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise SystemExit("magic invalid: 0x%08X (nu e un dump rtos_trace?)" % magic)
+
+    count = min(idx, size)
+    first = idx - count  # cea mai veche inregistrare ramasa in ring
+    records = []
+    for i in range(first, idx):
+        off = HEADER.size + (i % size) * RECORD.size
+        ts, info = RECORD.unpack_from(data, off)
+        records.append((ts, (info >> 24) & 0xFF, (info >> 16) & 0xFF, info & 0xFFFF))
+    return cpu_hz, records
+
+
+def task_name(task):
+    return "task %d" % (task - 1) if task else "kernel"
+
+
+def to_chrome(cpu_hz, records):
+    events = []
+    tids = set()
+    us_per_cycle = 1e6 / cpu_hz
+
+    # CYCCNT are 32 de biti: reconstruim un timp monoton din diferente; o
+    # diferenta negativa (dump-uri vechi, inregistrari neordonate) nu e un wrap
+    # de ~89 s, deci o tratam ca 0
+    elapsed = 0
+    prev_ts = records[0][0] if records else 0
+    running = None  # (task, t_start)
+
+    for ts, ev, task, obj in records:
+        elapsed += max(_signed32((ts - prev_ts) & 0xFFFFFFFF), 0)
+        prev_ts = ts
+        t_us = elapsed * us_per_cycle
+        name = EVENTS.get(ev, "EV_%d" % ev)
+
+        if ev == 1:  # TASK_SWITCH: inchidem felia task-ului anterior
+            if running is not None and running[0] != task:
+                events.append({"name": task_name(running[0]), "ph": "X", "pid": PID,
+                               "tid": running[0], "ts": running[1], "dur": t_us - running[1]})
+            if running is None or running[0] != task:
+                running = (task, t_us)
+            tids.add(task)
+        elif ev == 9:
+            events.append({"name": irq_name(obj), "ph": "B", "pid": PID,
+                           "tid": ISR_TID, "ts": t_us})
+        elif ev == 10:
+            events.append({"name": irq_name(obj), "ph": "E", "pid": PID,
+                           "tid": ISR_TID, "ts": t_us})
+        else:
+            tid = task if task else ISR_TID
+            tids.add(tid)
+            events.append({"name": name, "ph": "i", "s": "t", "pid": PID, "tid": tid,
+                           "ts": t_us, "args": {"obj": "0x%04X" % obj}})
+
+    if running is not None:
+        t_us = elapsed * us_per_cycle
+        events.append({"name": task_name(running[0]), "ph": "X", "pid": PID,
+                       "tid": running[0], "ts": running[1], "dur": t_us - running[1]})
+
+    tids.add(ISR_TID)
+    for tid in sorted(tids):
+        label = "ISR" if tid == ISR_TID else task_name(tid)
+        events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": tid,
+                       "args": {"name": label}})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def _signed32(v):
+    return v - 0x100000000 if v & 0x80000000 else v
+
+
+def _signed16(v):
+    return v - 0x10000 if v & 0x8000 else v
+
+
+def irq_name(obj):
+    irqn = _signed16(obj)
+    if irqn < 0:
+        return EXCEPTIONS.get(irqn, "exceptie %d" % (irqn + 16))
+    return "IRQ %d" % irqn
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write("utilizare: %s trace.bin > trace.json\n" % argv[0])
+        return 2
+    with open(argv[1], "rb") as f:
+        data = f.read()
+    cpu_hz, records = read_records(data)
+    json.dump(to_chrome(cpu_hz, records), sys.stdout, indent=1)
+    sys.stdout.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))